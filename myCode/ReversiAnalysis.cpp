@@ -0,0 +1,168 @@
+/*
+ * ReversiAnalysis.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include "ReversiAnalysis.h"
+#include "ReversiBoard.h"
+#include "ReversiConsoleView.h"
+#include "ReversiEngine.h"
+#include "ReversiGameFile.h"
+using namespace std;
+
+/**
+ * Constructor of class ReversiAnalysis
+ * \param int threadCount	: [IN] number of threads
+ * \param int hashSizeMb	: [IN] size of the shared hash table in
+ * 							megabytes
+ */
+ReversiAnalysis::ReversiAnalysis(int threadCount, int hashSizeMb):
+		pool(threadCount), hashTable(hashSizeMb)
+{
+}
+
+/**
+ * Follows the best moves stored in the hash table from a position. Stops
+ * at a position without stored move, at the end of the game or when the
+ * stored move is not valid, which happens if another position with the
+ * same slot has overwritten the entry
+ * \param const ReversiPosition& position	: [IN] start position
+ * \param int maxLength			: [IN] maximum number of moves
+ * \param std::vector<int>& line	: [IN,OUT] line the moves are
+ * 									appended to
+ */
+void ReversiAnalysis::extendLine(const ReversiPosition& position,
+		int maxLength, vector<int>& line)
+{
+	ReversiPosition current = position;
+	for (int length = 0; length < maxLength; length++){
+		uint64_t moves = current.validMoves();
+		if (moves == 0){
+			current = current.pass();
+			if (current.validMoves() == 0){
+				return;
+			}
+			line.push_back(-1);
+			continue;
+		}
+		int depth;
+		int score;
+		ReversiHashTable::BOUND_t bound;
+		int move;
+		if (!hashTable.probe(current.hash(), depth, score, bound, move) ||
+				move == ReversiHashTable::noMove ||
+				(moves & (1ULL << move)) == 0){
+			return;
+		}
+		line.push_back(move);
+		current = current.play(move);
+	}
+}
+
+/**
+ * Scores all valid moves of a position with iterative deepening. On
+ * every depth all root moves are searched in parallel with a full window,
+ * so each gets its exact score and not only a bound. The moves are sorted
+ * by the scores of the last depth, so the most promising ones are started
+ * first and fill the shared hash table for the others
+ * \param const ReversiPosition& position	: [IN] position to analyze
+ * \param int depth		: [IN] depth in moves, including the root move
+ * \return scores of the valid moves, best first, empty if the side to
+ * 			move has to pass
+ */
+vector<ReversiAnalysis::MoveScore> ReversiAnalysis::analyze(
+		const ReversiPosition& position, int depth)
+{
+	vector<MoveScore> scores;
+	for (uint64_t moves = position.validMoves(); moves; moves &= moves - 1){
+		scores.push_back(MoveScore{__builtin_ctzll(moves), 0, vector<int>()});
+	}
+	if (depth > position.getEmptyCount()){
+		depth = position.getEmptyCount();
+	}
+	hashTable.newSearch();
+
+	mutex doneMutex;
+	condition_variable allDone;
+	for (int iteration = 1; iteration <= depth; iteration++){
+		int pending = (int)scores.size();
+		for (size_t index = 0; index < scores.size(); index++){
+			pool.submit([&, index, iteration]{
+				ReversiEngine engine(hashTable);
+				int score = -engine.scorePosition(
+						position.play(scores[index].move), iteration - 1);
+				lock_guard<mutex> lock(doneMutex);
+				scores[index].score = score;
+				if (--pending == 0){
+					allDone.notify_all();
+				}
+			});
+		}
+		unique_lock<mutex> lock(doneMutex);
+		allDone.wait(lock, [&]{ return pending == 0; });
+		stable_sort(scores.begin(), scores.end(),
+				[](const MoveScore& first, const MoveScore& second){
+			return first.score > second.score;
+		});
+	}
+
+	for (size_t index = 0; index < scores.size(); index++){
+		scores[index].line.assign(1, scores[index].move);
+		extendLine(position.play(scores[index].move), depth - 1,
+				scores[index].line);
+	}
+	return scores;
+}
+
+/**
+ * Analyzes a position given as text of a position or as moves from the
+ * start position and prints the board with the scores
+ * \param const std::string& query	: [IN] position or moves
+ * \param int depth			: [IN] depth in moves
+ * \param int threadCount	: [IN] number of threads
+ * \return false if the query is neither a position nor valid moves
+ */
+bool ReversiAnalysis::run(const string& query, int depth, int threadCount)
+{
+	ReversiPosition position;
+	if (!ReversiPosition::fromString(query, position)){
+		vector<int> moves;
+		vector<ReversiPosition> positions;
+		if (!ReversiGameFile::parse(query, moves) ||
+				!ReversiGameFile::replay(moves, positions)){
+			cout << "Invalid position or moves: " << query << endl;
+			return false;
+		}
+		position = positions.back();
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	ReversiAnalysis analysis(threadCount);
+	vector<MoveScore> scores = analysis.analyze(position, depth);
+	double seconds = chrono::duration<double>(
+			chrono::steady_clock::now() - start).count();
+
+	ReversiBoard board;
+	board.setPosition(position);
+	ReversiConsoleView view(&board);
+	view.setAnalysis(&scores);
+	view.print();
+	cout << fixed << setprecision(2) << "Depth " << depth << ", " <<
+			threadCount << " threads, " << seconds << " s" << endl;
+	return true;
+}
+
+/**
+ * Destructor of class ReversiAnalysis
+ */
+ReversiAnalysis::~ReversiAnalysis()
+{
+}
@@ -0,0 +1,94 @@
+/*
+ * ReversiAnalysis.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIANALYSIS_H_
+#define REVERSIANALYSIS_H_
+
+#include <string>
+#include <vector>
+#include "ReversiHashTable.h"
+#include "ReversiPosition.h"
+#include "ReversiThreadPool.h"
+
+/**
+ * Multi-PV analysis: scores every valid move of a position, not only the
+ * best one. The root moves are searched in parallel, each by its own
+ * engine, and all engines share one hash table, so what one move's search
+ * finds out about a position speeds up the others
+ */
+class ReversiAnalysis
+{
+public:
+	/**
+	 * Result for one root move: the move as array index, its score in
+	 * 1/100 discs for the side to move and the expected line of play
+	 * starting with the move, -1 in the line for a pass
+	 */
+	struct MoveScore{
+		int move;
+		int score;
+		std::vector<int> line;
+	};
+
+private:
+	/**
+	 * Pool searching the root moves
+	 */
+	ReversiThreadPool pool;
+
+	/**
+	 * Hash table shared by the searches of all root moves
+	 */
+	ReversiHashTable hashTable;
+
+	/**
+	 * Follows the best moves stored in the hash table from a position
+	 * \param const ReversiPosition& position	: [IN] start position
+	 * \param int maxLength			: [IN] maximum number of moves
+	 * \param std::vector<int>& line	: [IN,OUT] line the moves are
+	 * 									appended to
+	 */
+	void extendLine(const ReversiPosition& position, int maxLength,
+			std::vector<int>& line);
+
+public:
+	/**
+	 * Constructor of class ReversiAnalysis
+	 * \param int threadCount	: [IN] number of threads
+	 * \param int hashSizeMb	: [IN] size of the shared hash table in
+	 * 							megabytes
+	 */
+	ReversiAnalysis(int threadCount, int hashSizeMb = 64);
+
+	/**
+	 * Scores all valid moves of a position with iterative deepening, on
+	 * every depth all root moves are searched in parallel
+	 * \param const ReversiPosition& position	: [IN] position to analyze
+	 * \param int depth		: [IN] depth in moves, including the root move
+	 * \return scores of the valid moves, best first, empty if the side to
+	 * 			move has to pass
+	 */
+	std::vector<MoveScore> analyze(const ReversiPosition& position,
+			int depth);
+
+	/**
+	 * Analyzes a position given as text of a position or as moves from the
+	 * start position and prints the board with the scores
+	 * \param const std::string& query	: [IN] position or moves
+	 * \param int depth			: [IN] depth in moves
+	 * \param int threadCount	: [IN] number of threads
+	 * \return false if the query is neither a position nor valid moves
+	 */
+	static bool run(const std::string& query, int depth, int threadCount);
+
+	/**
+	 * Destructor of class ReversiAnalysis
+	 */
+	virtual ~ReversiAnalysis();
+};
+
+#endif /* REVERSIANALYSIS_H_ */
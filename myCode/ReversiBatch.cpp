@@ -0,0 +1,453 @@
+/*
+ * ReversiBatch.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "ReversiBatch.h"
+using namespace std;
+
+#if defined(__x86_64__) || defined(__i386__)
+#define REVERSIBATCH_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * Shift counts and wrap masks of the 4 directions that shift to higher
+ * array indices (right, down, down right, down left). The 4 opposite
+ * directions shift by the same counts to lower indices with the mirrored
+ * masks
+ */
+static const int shiftCounts[4] = {1, 8, 9, 7};
+static const uint64_t leftShiftMasks[4] = {
+		0xFEFEFEFEFEFEFEFEULL, 0xFFFFFFFFFFFFFFFFULL,
+		0xFEFEFEFEFEFEFEFEULL, 0x7F7F7F7F7F7F7F7FULL,
+};
+static const uint64_t rightShiftMasks[4] = {
+		0x7F7F7F7F7F7F7F7FULL, 0xFFFFFFFFFFFFFFFFULL,
+		0x7F7F7F7F7F7F7F7FULL, 0xFEFEFEFEFEFEFEFEULL,
+};
+
+#ifdef REVERSIBATCH_X86
+
+/**
+ * Valid moves of 4 positions at a time with AVX2
+ * \param const uint64_t* players	: [IN] discs of the sides to move
+ * \param const uint64_t* opponents	: [IN] discs of the other sides
+ * \param uint64_t* moves			: [OUT] valid moves per position
+ * \param size_t count				: [IN] number of positions, multiple of 4
+ */
+__attribute__((target("avx2")))
+static void validMovesAvx2(const uint64_t* players, const uint64_t* opponents,
+		uint64_t* moves, size_t count)
+{
+	for (size_t index = 0; index < count; index += 4){
+		__m256i player = _mm256_loadu_si256((const __m256i*)(players + index));
+		__m256i opponent =
+				_mm256_loadu_si256((const __m256i*)(opponents + index));
+		__m256i result = _mm256_setzero_si256();
+		for (int direction = 0; direction < 4; direction++){
+			__m128i shiftCount = _mm_cvtsi32_si128(shiftCounts[direction]);
+			__m256i leftMask = _mm256_and_si256(opponent,
+					_mm256_set1_epi64x(leftShiftMasks[direction]));
+			__m256i rightMask = _mm256_and_si256(opponent,
+					_mm256_set1_epi64x(rightShiftMasks[direction]));
+			__m256i left = _mm256_and_si256(leftMask,
+					_mm256_sll_epi64(player, shiftCount));
+			__m256i right = _mm256_and_si256(rightMask,
+					_mm256_srl_epi64(player, shiftCount));
+			for (int step = 0; step < 5; step++){
+				left = _mm256_or_si256(left, _mm256_and_si256(leftMask,
+						_mm256_sll_epi64(left, shiftCount)));
+				right = _mm256_or_si256(right, _mm256_and_si256(rightMask,
+						_mm256_srl_epi64(right, shiftCount)));
+			}
+			result = _mm256_or_si256(result, _mm256_and_si256(
+					_mm256_sll_epi64(left, shiftCount),
+					_mm256_set1_epi64x(leftShiftMasks[direction])));
+			result = _mm256_or_si256(result, _mm256_and_si256(
+					_mm256_srl_epi64(right, shiftCount),
+					_mm256_set1_epi64x(rightShiftMasks[direction])));
+		}
+		result = _mm256_andnot_si256(_mm256_or_si256(player, opponent),
+				result);
+		_mm256_storeu_si256((__m256i*)(moves + index), result);
+	}
+}
+
+/**
+ * Flipped discs of 4 positions at a time with AVX2. In every direction
+ * the run of opponent discs next to the move is collected, it is flipped
+ * if an own disc follows
+ * \param const uint64_t* players	: [IN] discs of the sides to move
+ * \param const uint64_t* opponents	: [IN] discs of the other sides
+ * \param const uint8_t* indices	: [IN] array index of the move per
+ * 									position
+ * \param uint64_t* flipped			: [OUT] flipped discs per position
+ * \param size_t count				: [IN] number of positions, multiple of 4
+ */
+__attribute__((target("avx2")))
+static void flipsAvx2(const uint64_t* players, const uint64_t* opponents,
+		const uint8_t* indices, uint64_t* flipped, size_t count)
+{
+	for (size_t index = 0; index < count; index += 4){
+		__m256i player = _mm256_loadu_si256((const __m256i*)(players + index));
+		__m256i opponent =
+				_mm256_loadu_si256((const __m256i*)(opponents + index));
+		__m256i move = _mm256_sllv_epi64(_mm256_set1_epi64x(1),
+				_mm256_set_epi64x(indices[index + 3], indices[index + 2],
+						indices[index + 1], indices[index]));
+		__m256i zero = _mm256_setzero_si256();
+		__m256i result = zero;
+		for (int direction = 0; direction < 4; direction++){
+			__m128i shiftCount = _mm_cvtsi32_si128(shiftCounts[direction]);
+			__m256i leftMask = _mm256_and_si256(opponent,
+					_mm256_set1_epi64x(leftShiftMasks[direction]));
+			__m256i rightMask = _mm256_and_si256(opponent,
+					_mm256_set1_epi64x(rightShiftMasks[direction]));
+			__m256i left = _mm256_and_si256(leftMask,
+					_mm256_sll_epi64(move, shiftCount));
+			__m256i right = _mm256_and_si256(rightMask,
+					_mm256_srl_epi64(move, shiftCount));
+			for (int step = 0; step < 5; step++){
+				left = _mm256_or_si256(left, _mm256_and_si256(leftMask,
+						_mm256_sll_epi64(left, shiftCount)));
+				right = _mm256_or_si256(right, _mm256_and_si256(rightMask,
+						_mm256_srl_epi64(right, shiftCount)));
+			}
+			// Keep the runs that end at an own disc
+			__m256i leftEnd = _mm256_and_si256(player, _mm256_and_si256(
+					_mm256_sll_epi64(left, shiftCount),
+					_mm256_set1_epi64x(leftShiftMasks[direction])));
+			__m256i rightEnd = _mm256_and_si256(player, _mm256_and_si256(
+					_mm256_srl_epi64(right, shiftCount),
+					_mm256_set1_epi64x(rightShiftMasks[direction])));
+			result = _mm256_or_si256(result, _mm256_andnot_si256(
+					_mm256_cmpeq_epi64(leftEnd, zero), left));
+			result = _mm256_or_si256(result, _mm256_andnot_si256(
+					_mm256_cmpeq_epi64(rightEnd, zero), right));
+		}
+		// A move on an occupied field flips nothing
+		__m256i free = _mm256_cmpeq_epi64(zero, _mm256_and_si256(move,
+				_mm256_or_si256(player, opponent)));
+		_mm256_storeu_si256((__m256i*)(flipped + index),
+				_mm256_and_si256(result, free));
+	}
+}
+
+// The AVX-512 intrinsics of GCC 12 use uninitialised temporaries inside
+// the header, which triggers false warnings in the two kernels below
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+/**
+ * Valid moves of 8 positions at a time with AVX-512
+ * \param const uint64_t* players	: [IN] discs of the sides to move
+ * \param const uint64_t* opponents	: [IN] discs of the other sides
+ * \param uint64_t* moves			: [OUT] valid moves per position
+ * \param size_t count				: [IN] number of positions, multiple of 8
+ */
+__attribute__((target("avx512f")))
+static void validMovesAvx512(const uint64_t* players,
+		const uint64_t* opponents, uint64_t* moves, size_t count)
+{
+	for (size_t index = 0; index < count; index += 8){
+		__m512i player = _mm512_loadu_si512(players + index);
+		__m512i opponent = _mm512_loadu_si512(opponents + index);
+		__m512i result = _mm512_setzero_si512();
+		for (int direction = 0; direction < 4; direction++){
+			__m128i shiftCount = _mm_cvtsi32_si128(shiftCounts[direction]);
+			__m512i leftMask = _mm512_and_si512(opponent,
+					_mm512_set1_epi64(leftShiftMasks[direction]));
+			__m512i rightMask = _mm512_and_si512(opponent,
+					_mm512_set1_epi64(rightShiftMasks[direction]));
+			__m512i left = _mm512_and_si512(leftMask,
+					_mm512_sll_epi64(player, shiftCount));
+			__m512i right = _mm512_and_si512(rightMask,
+					_mm512_srl_epi64(player, shiftCount));
+			for (int step = 0; step < 5; step++){
+				left = _mm512_or_si512(left, _mm512_and_si512(leftMask,
+						_mm512_sll_epi64(left, shiftCount)));
+				right = _mm512_or_si512(right, _mm512_and_si512(rightMask,
+						_mm512_srl_epi64(right, shiftCount)));
+			}
+			result = _mm512_or_si512(result, _mm512_and_si512(
+					_mm512_sll_epi64(left, shiftCount),
+					_mm512_set1_epi64(leftShiftMasks[direction])));
+			result = _mm512_or_si512(result, _mm512_and_si512(
+					_mm512_srl_epi64(right, shiftCount),
+					_mm512_set1_epi64(rightShiftMasks[direction])));
+		}
+		result = _mm512_andnot_si512(_mm512_or_si512(player, opponent),
+				result);
+		_mm512_storeu_si512(moves + index, result);
+	}
+}
+
+/**
+ * Flipped discs of 8 positions at a time with AVX-512, works like
+ * flipsAvx2 with mask registers instead of compare results
+ * \param const uint64_t* players	: [IN] discs of the sides to move
+ * \param const uint64_t* opponents	: [IN] discs of the other sides
+ * \param const uint8_t* indices	: [IN] array index of the move per
+ * 									position
+ * \param uint64_t* flipped			: [OUT] flipped discs per position
+ * \param size_t count				: [IN] number of positions, multiple of 8
+ */
+__attribute__((target("avx512f")))
+static void flipsAvx512(const uint64_t* players, const uint64_t* opponents,
+		const uint8_t* indices, uint64_t* flipped, size_t count)
+{
+	for (size_t index = 0; index < count; index += 8){
+		__m512i player = _mm512_loadu_si512(players + index);
+		__m512i opponent = _mm512_loadu_si512(opponents + index);
+		__m512i move = _mm512_sllv_epi64(_mm512_set1_epi64(1),
+				_mm512_cvtepu8_epi64(_mm_loadl_epi64(
+						(const __m128i*)(indices + index))));
+		__m512i result = _mm512_setzero_si512();
+		for (int direction = 0; direction < 4; direction++){
+			__m128i shiftCount = _mm_cvtsi32_si128(shiftCounts[direction]);
+			__m512i leftShift = _mm512_set1_epi64(leftShiftMasks[direction]);
+			__m512i rightShift = _mm512_set1_epi64(rightShiftMasks[direction]);
+			__m512i leftMask = _mm512_and_si512(opponent, leftShift);
+			__m512i rightMask = _mm512_and_si512(opponent, rightShift);
+			__m512i left = _mm512_and_si512(leftMask,
+					_mm512_sll_epi64(move, shiftCount));
+			__m512i right = _mm512_and_si512(rightMask,
+					_mm512_srl_epi64(move, shiftCount));
+			for (int step = 0; step < 5; step++){
+				left = _mm512_or_si512(left, _mm512_and_si512(leftMask,
+						_mm512_sll_epi64(left, shiftCount)));
+				right = _mm512_or_si512(right, _mm512_and_si512(rightMask,
+						_mm512_srl_epi64(right, shiftCount)));
+			}
+			// Keep the runs that end at an own disc
+			__mmask8 leftEnd = _mm512_test_epi64_mask(player, _mm512_and_si512(
+					_mm512_sll_epi64(left, shiftCount), leftShift));
+			__mmask8 rightEnd = _mm512_test_epi64_mask(player,
+					_mm512_and_si512(_mm512_srl_epi64(right, shiftCount),
+							rightShift));
+			result = _mm512_mask_or_epi64(result, leftEnd, result, left);
+			result = _mm512_mask_or_epi64(result, rightEnd, result, right);
+		}
+		// A move on an occupied field flips nothing
+		__mmask8 occupied = _mm512_test_epi64_mask(move,
+				_mm512_or_si512(player, opponent));
+		_mm512_storeu_si512(flipped + index,
+				_mm512_maskz_mov_epi64(~occupied, result));
+	}
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+/**
+ * Returns the best instruction set the processor supports
+ * \return INSTRUCTIONSET_t	: [OUT] AVX512, AVX2 or SCALAR
+ */
+ReversiBatch::INSTRUCTIONSET_t ReversiBatch::bestInstructionSet()
+{
+#ifdef REVERSIBATCH_X86
+	if (__builtin_cpu_supports("avx512f")){
+		return AVX512;
+	}
+	if (__builtin_cpu_supports("avx2")){
+		return AVX2;
+	}
+#endif
+	return SCALAR;
+}
+
+/**
+ * Returns the name of an instruction set for reports
+ * \param INSTRUCTIONSET_t instructionSet	: [IN] instruction set
+ * \return name of the instruction set
+ */
+const char* ReversiBatch::getName(INSTRUCTIONSET_t instructionSet)
+{
+	switch (instructionSet){
+	case AVX512:
+		return "AVX-512";
+	case AVX2:
+		return "AVX2";
+	default:
+		return "scalar";
+	}
+}
+
+/**
+ * Splits positions into the two arrays of the batch layout
+ * \param const ReversiPosition* positions	: [IN] positions to split
+ * \param size_t count			: [IN] number of positions
+ * \param uint64_t* players		: [OUT] discs of the sides to move
+ * \param uint64_t* opponents	: [OUT] discs of the other sides
+ */
+void ReversiBatch::split(const ReversiPosition* positions, size_t count,
+		uint64_t* players, uint64_t* opponents)
+{
+	for (size_t index = 0; index < count; index++){
+		players[index] = positions[index].getPlayer();
+		opponents[index] = positions[index].getOpponent();
+	}
+}
+
+/**
+ * Computes the valid moves of all positions. The vector code handles
+ * full vectors, the rest of the batch is done one by one
+ * \param const uint64_t* players	: [IN] discs of the sides to move
+ * \param const uint64_t* opponents	: [IN] discs of the other sides
+ * \param uint64_t* moves			: [OUT] valid moves per position
+ * \param size_t count				: [IN] number of positions
+ * \param INSTRUCTIONSET_t instructionSet	: [IN] instruction set to use,
+ * 									must be supported by the processor
+ */
+void ReversiBatch::validMoves(const uint64_t* players,
+		const uint64_t* opponents, uint64_t* moves, size_t count,
+		INSTRUCTIONSET_t instructionSet)
+{
+	size_t done = 0;
+#ifdef REVERSIBATCH_X86
+	if (instructionSet == AVX512){
+		done = count & ~(size_t)7;
+		validMovesAvx512(players, opponents, moves, done);
+	}
+	else if (instructionSet == AVX2){
+		done = count & ~(size_t)3;
+		validMovesAvx2(players, opponents, moves, done);
+	}
+#endif
+	for (size_t index = done; index < count; index++){
+		moves[index] = ReversiPosition::validMoves(players[index],
+				opponents[index]);
+	}
+}
+
+/**
+ * Computes the discs flipped by one move in each position. The vector
+ * code handles full vectors, the rest of the batch is done one by one
+ * \param const uint64_t* players	: [IN] discs of the sides to move
+ * \param const uint64_t* opponents	: [IN] discs of the other sides
+ * \param const uint8_t* indices	: [IN] array index of the move per
+ * 									position
+ * \param uint64_t* flipped			: [OUT] flipped discs per position,
+ * 									0 if the move is not valid
+ * \param size_t count				: [IN] number of positions
+ * \param INSTRUCTIONSET_t instructionSet	: [IN] instruction set to use,
+ * 									must be supported by the processor
+ */
+void ReversiBatch::flips(const uint64_t* players, const uint64_t* opponents,
+		const uint8_t* indices, uint64_t* flipped, size_t count,
+		INSTRUCTIONSET_t instructionSet)
+{
+	size_t done = 0;
+#ifdef REVERSIBATCH_X86
+	if (instructionSet == AVX512){
+		done = count & ~(size_t)7;
+		flipsAvx512(players, opponents, indices, flipped, done);
+	}
+	else if (instructionSet == AVX2){
+		done = count & ~(size_t)3;
+		flipsAvx2(players, opponents, indices, flipped, done);
+	}
+#endif
+	for (size_t index = done; index < count; index++){
+		flipped[index] = ReversiPosition::flips(players[index],
+				opponents[index], indices[index]);
+	}
+}
+
+/**
+ * Counts the discs of both sides in all positions. The processor's
+ * popcount instruction handles one position per cycle, which is as fast
+ * as the loads, so there is no vector version
+ * \param const uint64_t* players	: [IN] discs of the sides to move
+ * \param const uint64_t* opponents	: [IN] discs of the other sides
+ * \param uint8_t* playerCounts		: [OUT] discs of the sides to move
+ * \param uint8_t* opponentCounts	: [OUT] discs of the other sides
+ * \param size_t count				: [IN] number of positions
+ */
+void ReversiBatch::discCounts(const uint64_t* players,
+		const uint64_t* opponents, uint8_t* playerCounts,
+		uint8_t* opponentCounts, size_t count)
+{
+	for (size_t index = 0; index < count; index++){
+		playerCounts[index] = (uint8_t)__builtin_popcountll(players[index]);
+		opponentCounts[index] =
+				(uint8_t)__builtin_popcountll(opponents[index]);
+	}
+}
+
+/**
+ * Measures the throughput of validMoves and flips for every supported
+ * instruction set on random positions and prints it. The positions are
+ * taken from random games, the moves are their first valid moves. The
+ * results of every instruction set are compared with the scalar ones
+ * \param size_t count	: [IN] number of positions per batch
+ */
+void ReversiBatch::benchmark(size_t count)
+{
+	vector<ReversiPosition> positions;
+	mt19937 random(1);
+	while (positions.size() < count){
+		ReversiPosition position = ReversiPosition::initial();
+		for (uint64_t moves = position.validMoves(); moves &&
+				positions.size() < count; moves = position.validMoves()){
+			positions.push_back(position);
+			int skip = random() % __builtin_popcountll(moves);
+			for (; skip > 0; skip--){
+				moves &= moves - 1;
+			}
+			position = position.play(__builtin_ctzll(moves));
+		}
+	}
+	vector<uint64_t> players(count);
+	vector<uint64_t> opponents(count);
+	vector<uint64_t> moves(count);
+	vector<uint64_t> expectedMoves(count);
+	vector<uint8_t> indices(count);
+	vector<uint64_t> flipped(count);
+	vector<uint64_t> expectedFlips(count);
+	split(&positions[0], count, &players[0], &opponents[0]);
+	validMoves(&players[0], &opponents[0], &expectedMoves[0], count, SCALAR);
+	for (size_t index = 0; index < count; index++){
+		indices[index] = (uint8_t)__builtin_ctzll(expectedMoves[index]);
+	}
+	flips(&players[0], &opponents[0], &indices[0], &expectedFlips[0], count,
+			SCALAR);
+
+	for (int set = SCALAR; set <= bestInstructionSet(); set++){
+		INSTRUCTIONSET_t instructionSet = (INSTRUCTIONSET_t)set;
+		int rounds = 0;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		double seconds = 0;
+		while (seconds < 0.5){
+			validMoves(&players[0], &opponents[0], &moves[0], count,
+					instructionSet);
+			rounds++;
+			seconds = chrono::duration<double>(
+					chrono::steady_clock::now() - start).count();
+		}
+		double moveRate = rounds * count / seconds;
+		rounds = 0;
+		start = chrono::steady_clock::now();
+		seconds = 0;
+		while (seconds < 0.5){
+			flips(&players[0], &opponents[0], &indices[0], &flipped[0],
+					count, instructionSet);
+			rounds++;
+			seconds = chrono::duration<double>(
+					chrono::steady_clock::now() - start).count();
+		}
+		double flipRate = rounds * count / seconds;
+		cout << getName(instructionSet) << ": valid moves " <<
+				(long)moveRate << " positions/s, flips " << (long)flipRate <<
+				" positions/s" << (moves == expectedMoves &&
+				flipped == expectedFlips ? "" : " (WRONG RESULTS)") << endl;
+	}
+}
@@ -0,0 +1,108 @@
+/*
+ * ReversiBatch.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIBATCH_H_
+#define REVERSIBATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include "ReversiPosition.h"
+
+/**
+ * Move generation for many positions in one call. The positions are
+ * passed as structure of arrays: element i of the players array holds
+ * the discs of the side to move of position i, element i of the
+ * opponents array the discs of the other side. This way neighboring
+ * positions sit in neighboring vector lanes and 4 (AVX2) or 8 (AVX-512)
+ * positions are processed with one instruction. The best instruction
+ * set of the processor is chosen at run time, without AVX2 or on other
+ * processors the positions are processed one by one
+ */
+class ReversiBatch
+{
+public:
+	/*
+	 * Enum to represent the instruction set used for a batch
+	 */
+	enum INSTRUCTIONSET_t{
+		SCALAR,
+		AVX2,
+		AVX512,
+	};
+
+	/**
+	 * Returns the best instruction set the processor supports
+	 * \return INSTRUCTIONSET_t	: [OUT] AVX512, AVX2 or SCALAR
+	 */
+	static INSTRUCTIONSET_t bestInstructionSet();
+
+	/**
+	 * Returns the name of an instruction set for reports
+	 * \param INSTRUCTIONSET_t instructionSet	: [IN] instruction set
+	 * \return name of the instruction set
+	 */
+	static const char* getName(INSTRUCTIONSET_t instructionSet);
+
+	/**
+	 * Splits positions into the two arrays of the batch layout
+	 * \param const ReversiPosition* positions	: [IN] positions to split
+	 * \param size_t count			: [IN] number of positions
+	 * \param uint64_t* players		: [OUT] discs of the sides to move
+	 * \param uint64_t* opponents	: [OUT] discs of the other sides
+	 */
+	static void split(const ReversiPosition* positions, size_t count,
+			uint64_t* players, uint64_t* opponents);
+
+	/**
+	 * Computes the valid moves of all positions
+	 * \param const uint64_t* players	: [IN] discs of the sides to move
+	 * \param const uint64_t* opponents	: [IN] discs of the other sides
+	 * \param uint64_t* moves			: [OUT] valid moves per position
+	 * \param size_t count				: [IN] number of positions
+	 * \param INSTRUCTIONSET_t instructionSet	: [IN] instruction set to use,
+	 * 									must be supported by the processor
+	 */
+	static void validMoves(const uint64_t* players, const uint64_t* opponents,
+			uint64_t* moves, size_t count,
+			INSTRUCTIONSET_t instructionSet = bestInstructionSet());
+
+	/**
+	 * Computes the discs flipped by one move in each position
+	 * \param const uint64_t* players	: [IN] discs of the sides to move
+	 * \param const uint64_t* opponents	: [IN] discs of the other sides
+	 * \param const uint8_t* indices	: [IN] array index of the move per
+	 * 									position
+	 * \param uint64_t* flipped			: [OUT] flipped discs per position,
+	 * 									0 if the move is not valid
+	 * \param size_t count				: [IN] number of positions
+	 * \param INSTRUCTIONSET_t instructionSet	: [IN] instruction set to use,
+	 * 									must be supported by the processor
+	 */
+	static void flips(const uint64_t* players, const uint64_t* opponents,
+			const uint8_t* indices, uint64_t* flipped, size_t count,
+			INSTRUCTIONSET_t instructionSet = bestInstructionSet());
+
+	/**
+	 * Counts the discs of both sides in all positions
+	 * \param const uint64_t* players	: [IN] discs of the sides to move
+	 * \param const uint64_t* opponents	: [IN] discs of the other sides
+	 * \param uint8_t* playerCounts		: [OUT] discs of the sides to move
+	 * \param uint8_t* opponentCounts	: [OUT] discs of the other sides
+	 * \param size_t count				: [IN] number of positions
+	 */
+	static void discCounts(const uint64_t* players, const uint64_t* opponents,
+			uint8_t* playerCounts, uint8_t* opponentCounts, size_t count);
+
+	/**
+	 * Measures the throughput of validMoves and flips for every supported
+	 * instruction set on random positions and prints it
+	 * \param size_t count	: [IN] number of positions per batch
+	 */
+	static void benchmark(size_t count);
+};
+
+#endif /* REVERSIBATCH_H_ */
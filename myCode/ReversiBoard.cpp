@@ -9,6 +9,31 @@
 #include "ReversiBoard.h"
 using namespace std;
 
+/**
+ * Fields on the row, the column and the two diagonals through each field,
+ * the field itself included. A disc set or flipped on a field can only
+ * change the valid moves and flips of these fields
+ */
+static const struct LineMasks{
+	uint64_t masks[64];
+	LineMasks(){
+		for (int index = 0; index < 64; index++){
+			int row = index / 8;
+			int column = index % 8;
+			masks[index] = 0;
+			for (int other = 0; other < 64; other++){
+				int otherRow = other / 8;
+				int otherColumn = other % 8;
+				if (otherRow == row || otherColumn == column ||
+						otherRow - otherColumn == row - column ||
+						otherRow + otherColumn == row + column){
+					masks[index] |= 1ULL << other;
+				}
+			}
+		}
+	}
+} lineMasks;
+
 /**
  * Default constructor that initializes row number and column number to 0,
  * default state to EMPTY.
@@ -17,7 +42,8 @@ using namespace std;
  * Here dynamic memory is not allocated as the size of the board of
  * Reversi game is fixed, that is 8
  */
-ReversiBoard::ReversiBoard(): rowNum(0), colNum(0), state{EMPTY}
+ReversiBoard::ReversiBoard(): rowNum(0), colNum(0), state{EMPTY},
+		discs{0, 0}, validMoveCache{0, 0}, staleSquares{~0ULL, ~0ULL}
 {
 	// TODO Auto-generated constructor stub
 	for (unsigned int index=0; index<boardSize * boardSize;index++){
@@ -29,6 +55,11 @@ ReversiBoard::ReversiBoard(): rowNum(0), colNum(0), state{EMPTY}
 			pBoard[(centerPiece + 1) * boardSize + (centerPiece + 1)]=PLAYER1;
 	pBoard[centerPiece * boardSize + (centerPiece + 1)] =
 			pBoard[(centerPiece + 1) * boardSize + centerPiece]=PLAYER2;
+	for (int index=0; index<boardSize * boardSize;index++){
+		if(pBoard[index] != EMPTY){
+			discs[pBoard[index] == PLAYER1 ? 0 : 1] |= 1ULL << index;
+		}
+	}
 }
 
 /**
@@ -78,12 +109,22 @@ ReversiBoard::FIELDSTATE_t ReversiBoard::getFieldState(int index)
 /**
  * Setting a field position 'index' on the Reversi board with the enum for
  * the corresponding player state, (PLAYER1, PLAYER2) or EMPTY
+ * The cached flips of all fields on the lines through the field are
+ * marked as stale, they are recomputed when they are asked for
  * \param int index			: [IN] the index at which the piece
  * 									needs to be set
  */
 void ReversiBoard::setFieldState(int index)
 {
 	pBoard[index] = state;
+	uint64_t bit = 1ULL << index;
+	discs[0] &= ~bit;
+	discs[1] &= ~bit;
+	if(state != EMPTY){
+		discs[state == PLAYER1 ? 0 : 1] |= bit;
+	}
+	staleSquares[0] |= lineMasks.masks[index];
+	staleSquares[1] |= lineMasks.masks[index];
 }
 
 /**
@@ -122,12 +163,11 @@ bool ReversiBoard::setField(int row, int column, bool player)
 
 /**
  * The validMove method makes sure there is no overwriting of pre-existing
- * pieces in the board and checks in 8 directions, Horizontal left, right,
- * Vertical up, down, Diagonal up left, up right, down left and down right if
- * the move is valid. Checks the result from each directions and even if one
- * of the outcomes is true, the row and column positions are valid
- * \returns false if a coin already exists in the position the user entered,
- * or true or false based on the individual result from each direction check.
+ * pieces in the board and looks up the coins the move flips in the flip
+ * cache, which holds the result of checking all 8 directions. If the move
+ * flips at least one coin it is valid and the coins are flipped
+ * \returns false if a coin already exists in the position the user entered
+ * or the move flips no coin, else true
  */
 bool ReversiBoard::validMove()
 {
@@ -138,405 +178,102 @@ bool ReversiBoard::validMove()
 			")"<<endl;
 		return false;
 	}
-	int currentIndex = getIndex(rowNum,colNum);
-	bool validMoveHorRight = horRightCheckNUpdate(currentIndex);
-	bool validMoveHorLeft = horLeftCheckNUpdate(currentIndex);
-	bool validMoveVertUp = vertUpCheckNUpdate(currentIndex);
-	bool validMoveVertDown = vertDownCheckNUpdate(currentIndex);
-	bool validMoveDiagUpRight = diagUpRightCheckNUpdate(currentIndex);
-	bool validMoveDiagDownRight =
-			diagDownRightCheckNUpdate(currentIndex);
-	bool validMoveDiagUpLeft = diagUpLeftCheckNUpdate(currentIndex);
-	bool validMoveDiagDownLeft =
-			diagDownLeftCheckNUpdate(currentIndex);
-
-	bool validMove = validMoveHorRight || validMoveHorLeft ||
-					   validMoveVertUp || validMoveVertDown ||
-					   validMoveDiagUpRight ||validMoveDiagDownRight ||
-					   validMoveDiagUpLeft ||validMoveDiagDownLeft;
-
-	return validMove;
-}
-
-/**
- * The horRightCheckNUpdate method checks if the given row and column input
- * positions are valid to horizontal right direction.
- * If an empty position is found to the right of the current position
- * or an element of same type occurs, false is returned, meaning
- * the move is invalid.
- * Else if a piece of opponent occurs to the right, it continues to check if
- * an element of current player's type occurs in same row, if yes
- * all the coin inbetween are flipped and true is returned
- * \param int currentIndex	:[IN] index of current player's coin to be set
- * \returns true if move is valid as described above and opponent coins
- * 			are flipped.
- * \returns false if the neighboring element is of same type of current
- * 			player or empty position.
- */
-bool ReversiBoard::horRightCheckNUpdate(int currentIndex)
-{
-	int opponentPlayerPiece = 0;
-	for (int index = currentIndex+1;
-			index <= ((rowNum-1)*boardSize)+boardSize;index++){
-		FIELDSTATE_t nxtEle = getFieldState(index);
-		if(nxtEle!=EMPTY){
-			if(nxtEle != state){
-				opponentPlayerPiece++;
-			}
-			else{
-				if(opponentPlayerPiece>0){
-					for(int flipIndex = currentIndex; flipIndex < index;
-							flipIndex++){
-						setFieldState(flipIndex);
-					}
-					return true;
-				}
-				else{
-					break;			// if neighboring element is of same type
-				}
-			}
-		}
-		else{
-			break;
-		}
+	uint64_t flipped = getFlips(getIndex(rowNum,colNum), state == PLAYER1);
+	if (flipped == 0){
+		return false;
 	}
-	return false;
-}
-
-/**
- * The horLeftCheckNUpdate method checks if the given row and column input
- * positions are valid to horizontal left direction.
- * If an empty position is found to the left of the current position
- * or an element of same type occurs, false is returned, meaning
- * the move is invalid.
- * Else if a piece of opponent occurs to the left, it continues to check if
- * an element of current player's type occurs in same row to left, if yes
- * all the coin inbetween are flipped and true is returned
- * \param int currentIndex	:[IN] index of current player's coin to be set
- * \returns true if move is valid as described above and opponent coins
- * 			are flipped.
- * \returns false if the neighboring element is of same type of current
- * 			player or empty position.
- */
-bool ReversiBoard::horLeftCheckNUpdate(int currentIndex)
-{
-
-	int opponentPlayerPiece = 0;
-	for (int index = currentIndex-1; index >= (rowNum-1) * boardSize;
-			index--){
-		FIELDSTATE_t nxtEle = getFieldState(index);
-		if(nxtEle!=EMPTY){
-			if(nxtEle != state){
-				opponentPlayerPiece++;
-			}
-			else{
-				if(opponentPlayerPiece>0){
-					for(int flipIndex = index; flipIndex < currentIndex;
-							flipIndex++) {
-						setFieldState(flipIndex);
-					}
-					return true;
-				}
-				else{
-					break;		// if neighboring element is of same type
-				}
-			}
-		}
-		else{
-			break;
-		}
+	for (; flipped; flipped &= flipped - 1){
+		setFieldState(__builtin_ctzll(flipped));
 	}
-	return false;
+	return true;
 }
 
 /**
- * The vertUpCheckNUpdate method checks if the given row and column input
- * positions are valid in Vertical up direction.
- * If an empty position is found above the current position, or an element
- * of same type occurs, false is returned, meaning the move is invalid.
- * Else if a piece of opponent occurs above, it continues to check if
- * an element of current player's type occurs in same column till the first
- * element in that column, if yes corresponding coins
- * in that column are flipped and true is returned
- * \param int currentIndex	:[IN] index of current player's coin to be set
- * \returns true if move is valid as described above and opponent coins
- * 			are flipped.
- * \returns false if the element above is of same type of current
- * 			player or empty position.
+ * Converts the board into a compact position
+ * \param bool player1			: [IN] true if PLAYER1 is to move
+ * \return ReversiPosition		: [OUT] discs of both players and the
+ * 									player to move
  */
-bool ReversiBoard::vertUpCheckNUpdate(int currentIndex)
+ReversiPosition ReversiBoard::getPosition(bool player1) const
 {
-	int opponentPlayerPiece = 0;
-	for(int index=currentIndex-boardSize; index >=0;index-=boardSize){
-		FIELDSTATE_t nxtEle = getFieldState(index);
-		if(nxtEle!=EMPTY){
-			if(nxtEle != state){
-				opponentPlayerPiece++;
-			}
-			else{
-				if(opponentPlayerPiece>0){
-					for(int flipIndex = index; flipIndex < currentIndex;
-							flipIndex+=boardSize) {
-						setFieldState(flipIndex);
-					}
-					return true;
-				}
-				else{
-					break;			// if neighboring element is of same type
-				}
-			}
-		}
-		else{
-			break;
-		}
-	}
-	return false;
+	return player1 ? ReversiPosition::create(discs[0], discs[1], true) :
+			ReversiPosition::create(discs[1], discs[0], false);
 }
 
 /**
- * The vertDownCheckNUpdate method checks if the given row and column input
- * positions are valid in Vertical down direction.
- * If an empty position is found below the current position, or an element
- * of same type occurs, false is returned, meaning the move is invalid.
- * Else if a piece of opponent occurs above, it continues to check if
- * an element of current player's type occurs in same column till the last
- * element in that column, if yes corresponding coins
- * in that column are flipped and true is returned
- * \param int currentIndex	:[IN] index of current player's coin to be set
- * \returns true if move is valid as described above and opponent coins
- * 			are flipped.
- * \returns false if the element below is of same type of current
- * 			player or empty position.
+ * Sets all fields of the board from a compact position. The player to
+ * move of the position becomes the current player state, so
+ * getPosition(state == PLAYER1) gives back the same position
+ * \param const ReversiPosition& position	: [IN] position to set
  */
-bool ReversiBoard::vertDownCheckNUpdate(int currentIndex)
+void ReversiBoard::setPosition(const ReversiPosition& position)
 {
-	int opponentPlayerPiece = 0;
-	for(int index=currentIndex+boardSize; index<boardSize*boardSize;
-							index+=boardSize){
-		FIELDSTATE_t nxtEle = getFieldState(index);
-		if(nxtEle!=EMPTY){
-			if(nxtEle != state){
-				opponentPlayerPiece++;
-			}
-			else{
-				if(opponentPlayerPiece>0){
-					for(int flipIndex = currentIndex; flipIndex <index ;
-							flipIndex+=boardSize) {
-						setFieldState(flipIndex);
-					}
-					return true;
-				}
-				else{
-					break;			// if neighboring element is of same type
-				}
-			}
+	state = position.isPlayer1ToMove() ? PLAYER1 : PLAYER2;
+	FIELDSTATE_t other = position.isPlayer1ToMove() ? PLAYER2 : PLAYER1;
+	for (int index=0; index<boardSize * boardSize;index++){
+		if((position.getPlayer() >> index) & 1){
+			pBoard[index] = state;
 		}
-		else{
-			break;
+		else if((position.getOpponent() >> index) & 1){
+			pBoard[index] = other;
 		}
-	}
-	return false;
-}
-
-/**
- * The diagUpRightCheckNUpdate method checks if the given row and column
- * input positions are valid in Diagonal direction.
- * If an empty position is found diagonal up and to the right of the
- * current position, or an element of same type occurs, false is returned,
- * meaning the move is invalid.
- * Else if a piece of opponent occurs diagonal up and to the right, it
- * continues to check if an element of current player's type occurs
- * diagonally till the last element in that diagonal,
- * if yes corresponding coins
- * in that diagonal are flipped and true is returned
- * \param int currentIndex	:[IN] index of current player's coin to be set
- * \returns true if move is valid as described above and opponent coins
- * 			are flipped.
- * \returns false if the element diagonal up and to the right is of same
- * 			type of current player or empty position.
- */
-bool ReversiBoard::diagUpRightCheckNUpdate(int currentIndex)
-{
-	int opponentPlayerPiece = 0;
-	int validColRow=0;
-	if(validColRow<=(boardSize - colNum)){
-		for(int index=currentIndex-boardSize+1; index >=0;
-				index-=(boardSize-1)){
-			FIELDSTATE_t nxtEle = getFieldState(index);
-			if(nxtEle!=EMPTY){
-				if(nxtEle != state){
-					opponentPlayerPiece++;
-				}
-				else{
-					if(opponentPlayerPiece>0){
-						for(int flipIndex = index; flipIndex < currentIndex;
-								flipIndex+=(boardSize-1)) {
-							setFieldState(flipIndex);
-						}
-						return true;
-					}
-					else{
-						break;		// if neighboring element is of same type
-					}
-				}
-			}
-			else{
-				break;
-			}
+		else{
+			pBoard[index] = EMPTY;
 		}
 	}
-	return false;
+	discs[0] = position.isPlayer1ToMove() ? position.getPlayer() :
+			position.getOpponent();
+	discs[1] = position.isPlayer1ToMove() ? position.getOpponent() :
+			position.getPlayer();
+	staleSquares[0] = staleSquares[1] = ~0ULL;
 }
 
 /**
- * The diagDownRightCheckNUpdate method checks if the given row and column
- * input positions are valid in Diagonal direction.
- * If an empty position is found diagonal up and to the right of the
- * current position, or an element of same type occurs, false is returned,
- * meaning the move is invalid.
- * Else if a piece of opponent occurs diagonal down and to the right, it
- * continues to check if an element of current player's type occurs
- * diagonally till the last element in that direction,
- * if yes corresponding coins
- * in that diagonal are flipped and true is returned
- * \param int currentIndex	:[IN] index of current player's coin to be set
- * \returns true if move is valid as described above and opponent coins
- * 			are flipped.
- * \returns false if the element diagonal down and to the right is of same
- * 			type of current player or empty position.
+ * Checks if a player has at least one valid move on the board
+ * \param bool player1	: [IN] true to check for PLAYER1
+ * \return true if the player can move, false if the player has to pass
  */
-bool ReversiBoard::diagDownRightCheckNUpdate(int currentIndex)
+bool ReversiBoard::hasValidMove(bool player1) const
 {
-	int opponentPlayerPiece = 0;
-	int validColRow=0;
-	if(validColRow<=(boardSize - colNum)){
-		for(int index=currentIndex+boardSize+1; index <boardSize*boardSize;
-						index+=(boardSize+1)){
-			FIELDSTATE_t nxtEle = getFieldState(index);
-			if(nxtEle!=EMPTY){
-				if(nxtEle != state){
-					opponentPlayerPiece++;
-				}
-				else{
-					if(opponentPlayerPiece>0){
-						for (int flipIndex = currentIndex; flipIndex < index;
-								flipIndex+=(boardSize+1)){
-							setFieldState(flipIndex);
-						}
-						return true;
-					}
-					else{
-						break;		// if neighboring element is of same type
-					}
-				}
-			}
-			else{
-				break;
-			}
-		}
-	}
-	return false;
+	return getValidMoves(player1) != 0;
 }
 
 /**
- * The diagUpLeftCheckNUpdate method checks if the given row and column
- * input positions are valid in Diagonal direction.
- * If an empty position is found diagonal up and to the left of the
- * current position, or an element of same type occurs, false is returned,
- * meaning the move is invalid.
- * Else if a piece of opponent occurs diagonal up and to the left, it
- * continues to check if an element of current player's type occurs
- * diagonally till the last element in that direction,
- * if yes corresponding coins
- * in that diagonal are flipped and true is returned
- * \param int currentIndex	:[IN] index of current player's coin to be set
- * \returns true if move is valid as described above and opponent coins
- * 			are flipped.
- * \returns false if the element diagonal up and to the left is of same
- * 			type of current player or empty position.
+ * Returns the valid moves of a player. Only the fields marked as stale
+ * since the last call are checked again, all others come from the cache
+ * \param bool player1	: [IN] true for the moves of PLAYER1
+ * \return bit board of the valid moves
  */
-bool ReversiBoard::diagUpLeftCheckNUpdate(int currentIndex)
+uint64_t ReversiBoard::getValidMoves(bool player1) const
 {
-	int opponentPlayerPiece = 0;
-	int validColRow=0;
-	if(validColRow<=(colNum)){
-		for(int index=currentIndex-boardSize-1; index >=0;
-				index-=(boardSize+1)){
-			FIELDSTATE_t nxtEle = getFieldState(index);
-			if(nxtEle!=EMPTY){
-				if(nxtEle != state){
-					opponentPlayerPiece++;
-				}
-				else{
-					if(opponentPlayerPiece>0){
-						for (int flipIndex = index; flipIndex < currentIndex;
-								flipIndex+=(boardSize+1)){
-							setFieldState(flipIndex);
-						}
-						return true;
-					}
-					else{
-						break;		// if neighboring element is of same type
-					}
-				}
-			}
-			else{
-				break;
-			}
-		}
+	int side = player1 ? 0 : 1;
+	for (uint64_t stale = staleSquares[side]; stale; stale &= stale - 1){
+		getFlips(__builtin_ctzll(stale), player1);
 	}
-	return false;
-
+	return validMoveCache[side];
 }
 
 /**
- * The diagDownLeftCheckNUpdate method checks if the given row and column
- * input positions are valid in Diagonal direction.
- * If an empty position is found diagonal down and to the left of the
- * current position, or an element of same type occurs, false is returned,
- * meaning the move is invalid.
- * Else if a piece of opponent occurs diagonal down and to the left, it
- * continues to check if an element of current player's type occurs
- * diagonally till the last element in that direction,
- * if yes corresponding coins
- * in that diagonal are flipped and true is returned
- * \param int currentIndex	:[IN] index of current player's coin to be set
- * \returns true if move is valid as described above and opponent coins
- * 			are flipped.
- * \returns false if the element diagonal down and to the left is of same
- * 			type of current player or empty position.
+ * Returns the coins a move flips. The flips of a field are only computed
+ * again if a coin on one of the lines through the field has changed
+ * since they were cached
+ * \param int index		: [IN] array index of the move
+ * \param bool player1	: [IN] true for a move of PLAYER1
+ * \return bit board of the flipped coins, 0 if the move is not valid
  */
-bool ReversiBoard::diagDownLeftCheckNUpdate(int currentIndex)
+uint64_t ReversiBoard::getFlips(int index, bool player1) const
 {
-	int opponentPlayerPiece = 0;
-	int validColRow=0;
-	if(validColRow<=(colNum)){
-		for(int index=currentIndex+boardSize-1;
-				index <boardSize*boardSize;index+=(boardSize-1)){
-			FIELDSTATE_t nxtEle = getFieldState(index);
-			if(nxtEle!=EMPTY){
-				if(nxtEle != state){
-					opponentPlayerPiece++;
-				}
-				else{
-					if(opponentPlayerPiece>0){
-						for (int flipIndex = currentIndex; flipIndex < index;
-								flipIndex+=(boardSize-1)){
-							setFieldState(flipIndex);
-						}
-						return true;
-					}
-					else{
-						break;		// if neighboring element is of same type
-					}
-				}
-			}
-			else{
-				break;
-			}
-		}
+	int side = player1 ? 0 : 1;
+	uint64_t bit = 1ULL << index;
+	if (staleSquares[side] & bit){
+		uint64_t flipped = ((discs[0] | discs[1]) & bit) ? 0 :
+				ReversiPosition::flips(discs[side], discs[1 - side], index);
+		flipCache[side][index] = flipped;
+		validMoveCache[side] = flipped ? validMoveCache[side] | bit :
+				validMoveCache[side] & ~bit;
+		staleSquares[side] &= ~bit;
 	}
-	return false;
+	return flipCache[side][index];
 }
 
 /**
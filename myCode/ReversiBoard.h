@@ -8,6 +8,8 @@
 #ifndef REVERSIBOARD_H_
 #define REVERSIBOARD_H_
 
+#include "ReversiPosition.h"
+
 class ReversiBoard
 {
 	/*
@@ -47,174 +49,54 @@ class ReversiBoard
 	FIELDSTATE_t state;
 
 	/**
-	 * Allows the ReversiConsoleView to access private members of
-	 * ReversiBoard class
+	 * Bit boards of the coins of PLAYER1 (0) and PLAYER2 (1), kept equal
+	 * to pBoard
 	 */
-	friend class ReversiConsoleView;
+	uint64_t discs[2];
 
 	/**
-	 * Translates a row and a column into a array index
-	 * \param int row		: [IN] row number
-	 * \param int column	: [IN] column number
-	 * \return Index of the array based on the row and column number
+	 * Coins flipped by a move of PLAYER1 (0) or PLAYER2 (1) on each field,
+	 * 0 if the move is not valid
 	 */
-	int getIndex(int row, int column);
+	mutable uint64_t flipCache[2][boardSize*boardSize];
 
 	/**
-	 * The validMove method makes sure there is no overwriting of pre-existing
-	 * pieces in the board and checks in 8 directions, Horizontal left, right,
-	 * Vertical up, down, Diagonal up left, up right, down left and down right
-	 * if the move is valid. Checks the result from each directions and even
-	 * if one of the outcomes is true, the row and column positions are valid
-	 * \returns false if a coin already exists in the position the user
-	 * entered,or true or false based on the individual result from each
-	 * direction check
+	 * Valid moves of PLAYER1 (0) and PLAYER2 (1), the bits of stale fields
+	 * may be outdated
 	 */
-	bool validMove();
+	mutable uint64_t validMoveCache[2];
 
 	/**
-	 * The horRightCheckNUpdate method checks if the given row and column
-	 * input positions are valid to horizontal right direction.
-	 * If an empty position is found to the right of the current position
-	 * or an element of same type occurs, false is returned, meaning
-	 * the move is invalid.
-	 * Else if a piece of opponent occurs to the right, it continues to check
-	 * if an element of current player's type occurs in same row, if yes
-	 * all the coin inbetween are flipped and true is returned
-	 * \param int currentIndex	:[IN] index of current player's coin to be set
-	 * \returns true if move is valid as described above and opponent coins
-	 * 			are flipped.
-	 * \returns false if the neighboring element is of same type of current
-	 * 			player or empty position.
+	 * Fields whose cached flips are outdated, because a coin on one of the
+	 * lines through the field has changed. They are computed again when
+	 * they are asked for
 	 */
-	bool horRightCheckNUpdate(int currentIndex);
+	mutable uint64_t staleSquares[2];
 
 	/**
-	 * The horLeftCheckNUpdate method checks if the given row and column input
-	 * positions are valid to horizontal left direction.
-	 * If an empty position is found to the left of the current position
-	 * or an element of same type occurs, false is returned, meaning
-	 * the move is invalid.
-	 * Else if a piece of opponent occurs to the left, it continues to check
-	 * if an element of current player's type occurs in same row to left, if
-	 * yes all the coin inbetween are flipped and true is returned
-	 * \param int currentIndex	:[IN] index of current player's coin to be set
-	 * \returns true if move is valid as described above and opponent coins
-	 * 			are flipped.
-	 * \returns false if the neighboring element is of same type of current
-	 * 			player or empty position.
-	 */
-	bool horLeftCheckNUpdate(int currentIndex);
-
-	/**
-	 * The vertUpCheckNUpdate method checks if the given row and column input
-	 * positions are valid in Vertical up direction.
-	 * If an empty position is found above the current position, or an element
-	 * of same type occurs, false is returned, meaning the move is invalid.
-	 * Else if a piece of opponent occurs above, it continues to check if
-	 * an element of current player's type occurs in same column till the
-	 * first element in that column, if yes corresponding coins
-	 * in that column are flipped and true is returned
-	 * \param int currentIndex	:[IN] index of current player's coin to be set
-	 * \returns true if move is valid as described above and opponent coins
-	 * 			are flipped.
-	 * \returns false if the element above is of same type of current
-	 * 			player or empty position.
-	 */
-	bool vertUpCheckNUpdate(int currentIndex);
-
-	/**
-	 * The vertDownCheckNUpdate method checks if the given row and column
-	 * input positions are valid in Vertical down direction.
-	 * If an empty position is found below the current position, or an element
-	 * of same type occurs, false is returned, meaning the move is invalid.
-	 * Else if a piece of opponent occurs above, it continues to check if
-	 * an element of current player's type occurs in same column till the last
-	 * element in that column, if yes corresponding coins
-	 * in that column are flipped and true is returned
-	 * \param int currentIndex	:[IN] index of current player's coin to be set
-	 * \returns true if move is valid as described above and opponent coins
-	 * 			are flipped.
-	 * \returns false if the element below is of same type of current
-	 * 			player or empty position.
-	 */
-	bool vertDownCheckNUpdate(int currentIndex);
-
-	/**
-	 * The diagUpRightCheckNUpdate method checks if the given row and column
-	 * input positions are valid in Diagonal direction.
-	 * If an empty position is found diagonal up and to the right of the
-	 * current position, or an element of same type occurs, false is returned,
-	 * meaning the move is invalid.
-	 * Else if a piece of opponent occurs diagonal up and to the right, it
-	 * continues to check if an element of current player's type occurs
-	 * diagonally till the last element in that diagonal,
-	 * if yes corresponding coins
-	 * in that diagonal are flipped and true is returned
-	 * \param int currentIndex	:[IN] index of current player's coin to be set
-	 * \returns true if move is valid as described above and opponent coins
-	 * 			are flipped.
-	 * \returns false if the element diagonal up and to the right is of same
-	 * 			type of current player or empty position.
+	 * Allows the ReversiConsoleView to access private members of
+	 * ReversiBoard class
 	 */
-	bool diagUpRightCheckNUpdate(int currentIndex);
+	friend class ReversiConsoleView;
 
 	/**
-	 * The diagDownRightCheckNUpdate method checks if the given row and column
-	 * input positions are valid in Diagonal direction.
-	 * If an empty position is found diagonal up and to the right of the
-	 * current position, or an element of same type occurs, false is returned,
-	 * meaning the move is invalid.
-	 * Else if a piece of opponent occurs diagonal down and to the right, it
-	 * continues to check if an element of current player's type occurs
-	 * diagonally till the last element in that direction,
-	 * if yes corresponding coins
-	 * in that diagonal are flipped and true is returned
-	 * \param int currentIndex	:[IN] index of current player's coin to be set
-	 * \returns true if move is valid as described above and opponent coins
-	 * 			are flipped.
-	 * \returns false if the element diagonal down and to the right is of same
-	 * 			type of current player or empty position.
+	 * Translates a row and a column into a array index
+	 * \param int row		: [IN] row number
+	 * \param int column	: [IN] column number
+	 * \return Index of the array based on the row and column number
 	 */
-	bool diagDownRightCheckNUpdate(int currentIndex);
+	int getIndex(int row, int column);
 
 	/**
-	 * The diagUpLeftCheckNUpdate method checks if the given row and column
-	 * input positions are valid in Diagonal direction.
-	 * If an empty position is found diagonal up and to the left of the
-	 * current position, or an element of same type occurs, false is returned,
-	 * meaning the move is invalid.
-	 * Else if a piece of opponent occurs diagonal up and to the left, it
-	 * continues to check if an element of current player's type occurs
-	 * diagonally till the last element in that direction,
-	 * if yes corresponding coins
-	 * in that diagonal are flipped and true is returned
-	 * \param int currentIndex	:[IN] index of current player's coin to be set
-	 * \returns true if move is valid as described above and opponent coins
-	 * 			are flipped.
-	 * \returns false if the element diagonal up and to the left is of same
-	 * 			type of current player or empty position.
+	 * The validMove method makes sure there is no overwriting of pre-existing
+	 * pieces in the board and looks up the coins the move flips in the flip
+	 * cache, which holds the result of checking all 8 directions. If the
+	 * move flips at least one coin it is valid and the coins are flipped
+	 * \returns false if a coin already exists in the position the user
+	 * entered or the move flips no coin, else true
 	 */
-	bool diagUpLeftCheckNUpdate(int currentIndex);
+	bool validMove();
 
-	/**
-	 * The diagDownLeftCheckNUpdate method checks if the given row and column
-	 * input positions are valid in Diagonal direction.
-	 * If an empty position is found diagonal down and to the left of the
-	 * current position, or an element of same type occurs, false is returned,
-	 * meaning the move is invalid.
-	 * Else if a piece of opponent occurs diagonal down and to the left, it
-	 * continues to check if an element of current player's type occurs
-	 * diagonally till the last element in that direction,
-	 * if yes corresponding coins
-	 * in that diagonal are flipped and true is returned
-	 * \param int currentIndex	:[IN] index of current player's coin to be set
-	 * \returns true if move is valid as described above and opponent coins
-	 * 			are flipped.
-	 * \returns false if the element diagonal down and to the left is of same
-	 * 			type of current player or empty position.
-	 */
-	bool diagDownLeftCheckNUpdate(int currentIndex);
 
 public:
 
@@ -271,6 +153,47 @@ public:
 	 */
 	bool setField(int row, int column, bool state);
 
+	/**
+	 * Converts the board into a compact position
+	 * \param bool player1			: [IN] true if PLAYER1 is to move
+	 * \return ReversiPosition		: [OUT] discs of both players and the
+	 * 									player to move
+	 */
+	ReversiPosition getPosition(bool player1) const;
+
+	/**
+	 * Sets all fields of the board from a compact position. The player to
+	 * move of the position becomes the current player state, so
+	 * getPosition(state == PLAYER1) gives back the same position
+	 * \param const ReversiPosition& position	: [IN] position to set
+	 */
+	void setPosition(const ReversiPosition& position);
+
+	/**
+	 * Checks if a player has at least one valid move on the board
+	 * \param bool player1	: [IN] true to check for PLAYER1
+	 * \return true if the player can move, false if the player has to pass
+	 */
+	bool hasValidMove(bool player1) const;
+
+	/**
+	 * Returns the valid moves of a player. Only the fields marked as stale
+	 * since the last call are checked again, all others come from the cache
+	 * \param bool player1	: [IN] true for the moves of PLAYER1
+	 * \return bit board of the valid moves
+	 */
+	uint64_t getValidMoves(bool player1) const;
+
+	/**
+	 * Returns the coins a move flips. The flips of a field are only
+	 * computed again if a coin on one of the lines through the field has
+	 * changed since they were cached
+	 * \param int index		: [IN] array index of the move
+	 * \param bool player1	: [IN] true for a move of PLAYER1
+	 * \return bit board of the flipped coins, 0 if the move is not valid
+	 */
+	uint64_t getFlips(int index, bool player1) const;
+
 	/**
 	 * Destructor that deallocated/frees the dynamic memory and destroys the
 	 * objects created. Here no dynamic memory is allocated as the size of the
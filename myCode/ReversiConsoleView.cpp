@@ -6,15 +6,31 @@
  */
 
 #include "ReversiConsoleView.h"
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include "ReversiEngine.h"
 using namespace std;
 
+/**
+ * Formats a score in 1/100 discs as discs with sign
+ * \param int score	: [IN] score in 1/100 discs
+ * \return text like +2.50
+ */
+static string formatScore(int score)
+{
+	stringstream text;
+	text << (score >= 0 ? "+" : "-") << fixed << setprecision(2) <<
+			abs(score) / (double)ReversiEngine::scoreDisc;
+	return text.str();
+}
+
 /**
  * Constructor for class ReversiConsoleView
  * \param const ReversiBoard* revboard :[IN] pointer to reversi board
  */
 ReversiConsoleView::ReversiConsoleView(ReversiBoard* revboard):
-		board(revboard)
+		board(revboard), analysis(nullptr)
 {
 }
 
@@ -46,11 +62,59 @@ void ReversiConsoleView::print() const
 	                coin = ' ';
 	        }
 
+	        if (analysis && state == ReversiBoard::EMPTY){
+	        	// Score of a valid move, number of a later move of the best
+	        	// line, both or the empty field
+	        	stringstream field;
+	        	for (size_t move = 0; move < analysis->size(); move++){
+	        		if ((*analysis)[move].move == index){
+	        			field << (move == 0 ? "*" : "") <<
+	        					formatScore((*analysis)[move].score);
+	        		}
+	        	}
+	        	for (size_t ply = 1; !analysis->empty() &&
+	        			ply < analysis->front().line.size(); ply++){
+	        		if (analysis->front().line[ply] == index){
+	        			field << "(" << ply + 1 << ")";
+	        			break;
+	        		}
+	        	}
+	        	cout << (field.str().empty() ? "." : field.str()) << "\t";
+	        	continue;
+	        }
+
 	        cout << coin << "\t";
 	    }
 	}
 
 		cout<<endl;
+	if (analysis){
+		for (size_t move = 0; move < analysis->size(); move++){
+			const ReversiAnalysis::MoveScore& score = (*analysis)[move];
+			cout << (move == 0 ? "* " : "  ") <<
+					ReversiPosition::moveToString(score.move) << " " <<
+					formatScore(score.score) << " :";
+			for (size_t ply = 0; ply < score.line.size(); ply++){
+				cout << " " << ReversiPosition::moveToString(score.line[ply]);
+			}
+			cout << endl;
+		}
+	}
+}
+
+/**
+ * Switches the analysis mode on or off. In analysis mode print shows the
+ * score of every valid move on its field, marks the best move with * and
+ * the later moves of the best line with their number, and lists the lines
+ * of all moves below the board. The scores have to stay valid while they
+ * are shown
+ * \param const std::vector<ReversiAnalysis::MoveScore>* scores	: [IN]
+ * 			scores of ReversiAnalysis::analyze, nullptr to switch off
+ */
+void ReversiConsoleView::setAnalysis(
+		const vector<ReversiAnalysis::MoveScore>* scores)
+{
+	analysis = scores;
 }
 
 /**
@@ -7,6 +7,8 @@
 
 #ifndef REVERSICONSOLEVIEW_H_
 #define REVERSICONSOLEVIEW_H_
+#include <vector>
+#include "ReversiAnalysis.h"
 #include "ReversiBoard.h"
 
 class ReversiConsoleView
@@ -15,6 +17,12 @@ class ReversiConsoleView
 	 * Pointer to the reversi board
 	 */
 	ReversiBoard* board;
+
+	/**
+	 * Scores of the valid moves shown on the board, nullptr to show the
+	 * discs only
+	 */
+	const std::vector<ReversiAnalysis::MoveScore>* analysis;
 public:
 
 	/**
@@ -30,6 +38,17 @@ public:
 	 */
 	void print() const;
 
+	/**
+	 * Switches the analysis mode on or off. In analysis mode print shows
+	 * the score of every valid move on its field, marks the best move with
+	 * * and the later moves of the best line with their number, and lists
+	 * the lines of all moves below the board. The scores have to stay
+	 * valid while they are shown
+	 * \param const std::vector<ReversiAnalysis::MoveScore>* scores	: [IN]
+	 * 			scores of ReversiAnalysis::analyze, nullptr to switch off
+	 */
+	void setAnalysis(const std::vector<ReversiAnalysis::MoveScore>* scores);
+
 	/**
 	 * Destructor of class ReversiConsoleView, destroys the object
 	 */
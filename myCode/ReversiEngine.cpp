@@ -0,0 +1,617 @@
+/*
+ * ReversiEngine.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include "ReversiEngine.h"
+using namespace std;
+
+/**
+ * Bit board masks of the square classes used by the evaluation, from
+ * corners over the edges to the center, and the weight of each class
+ */
+static const uint64_t squareClasses[7] = {
+		0x8100000000000081ULL,		// corners
+		0x0042000000004200ULL,		// fields diagonal to the corners
+		0x4281000000008142ULL,		// edge fields next to the corners
+		0x2400810000810024ULL,		// edge fields two away from the corners
+		0x1800008181000018ULL,		// edge fields in the middle
+		0x003C424242423C00ULL,		// second ring
+		0x00003C3C3C3C0000ULL,		// center
+};
+static const int squareWeights[7] = {100, -50, -20, 10, 5, -2, -1};
+
+/**
+ * Weight of one move of mobility difference in the evaluation
+ */
+static const int mobilityWeight = 8;
+
+/**
+ * Constructor of class ReversiEngine with its time control
+ * \param int moveTimeMs	: [IN] maximum thinking time per move
+ * \param int gameTimeMs	: [IN] thinking time for the whole game
+ * \param int hashSizeMb	: [IN] size of the hash table in megabytes
+ */
+ReversiEngine::ReversiEngine(int moveTimeMs, int gameTimeMs, int hashSizeMb):
+		ownHashTable(new ReversiHashTable(hashSizeMb)),
+		hashTable(ownHashTable.get()),
+		moveTimeMs(moveTimeMs), clockMs(gameTimeMs),
+		persistentCache(nullptr), probCut(nullptr), probCutSigmas(0),
+		nodes(0), nodeLimit(0), stopFlag(false), cancelSignal(nullptr),
+		hardDeadline(0), softDeadline(0),
+		stableDeadline(0), ponderPosition(ReversiPosition::initial()),
+		ponderStartMs(0), result{-1, 0, 0, 0, -1}
+{
+}
+
+/**
+ * Constructor of class ReversiEngine for searches without time control
+ * that use a hash table shared with other engines, no own table is
+ * allocated. The table has to stay valid while the engine uses it
+ * \param ReversiHashTable& sharedTable	: [IN] table to use
+ */
+ReversiEngine::ReversiEngine(ReversiHashTable& sharedTable):
+		hashTable(&sharedTable), moveTimeMs(0), clockMs(0),
+		persistentCache(nullptr), probCut(nullptr), probCutSigmas(0),
+		nodes(0), nodeLimit(0), stopFlag(false), cancelSignal(nullptr),
+		hardDeadline(0), softDeadline(0),
+		stableDeadline(0), ponderPosition(ReversiPosition::initial()),
+		ponderStartMs(0), result{-1, 0, 0, 0, -1}
+{
+}
+
+/**
+ * Returns a monotonic time stamp
+ * \return milliseconds since an arbitrary fixed point
+ */
+int64_t ReversiEngine::nowMs()
+{
+	return chrono::duration_cast<chrono::milliseconds>(
+			chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Static evaluation of a position from the view of the side to move,
+ * based on square weights and mobility
+ * \param const ReversiPosition& position	: [IN] position to evaluate
+ * \return score in 1/100 discs
+ */
+int ReversiEngine::evaluate(const ReversiPosition& position)
+{
+	uint64_t player = position.getPlayer();
+	uint64_t opponent = position.getOpponent();
+	int score = 0;
+	for (int squareClass = 0; squareClass < 7; squareClass++){
+		score += squareWeights[squareClass] *
+				(__builtin_popcountll(player & squareClasses[squareClass]) -
+				__builtin_popcountll(opponent & squareClasses[squareClass]));
+	}
+	score += mobilityWeight *
+			(__builtin_popcountll(ReversiPosition::validMoves(player,
+					opponent)) -
+			__builtin_popcountll(ReversiPosition::validMoves(opponent,
+					player)));
+	return score;
+}
+
+/**
+ * Checks if the running search has to be aborted. Passing the hard
+ * deadline or the node limit or a set cancel signal cancels the search
+ * like stopPondering does
+ * \return true if cancelled, out of time or out of nodes
+ */
+bool ReversiEngine::timeUp()
+{
+	if (stopFlag.load(memory_order_relaxed)){
+		return true;
+	}
+	if ((cancelSignal && cancelSignal->load(memory_order_relaxed)) ||
+			nowMs() >= hardDeadline.load(memory_order_relaxed) ||
+			(nodeLimit != 0 && nodes >= nodeLimit)){
+		stopFlag.store(true, memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Alpha-beta search in negamax form with the hash table. A pass does not
+ * use up depth, two passes in a row end the game and the final disc
+ * difference is returned. Every move creates a new position on the stack,
+ * nothing has to be taken back
+ * \param const ReversiPosition& position	: [IN] position to search
+ * \param int depth			: [IN] remaining depth in moves
+ * \param int alpha			: [IN] lower limit of the search window
+ * \param int beta			: [IN] upper limit of the search window
+ * \param bool passed		: [IN] true if the last move was a pass
+ * \return score of the position, meaningless if the search was aborted
+ */
+int ReversiEngine::search(const ReversiPosition& position, int depth,
+		int alpha, int beta, bool passed)
+{
+	nodes++;
+	if ((nodes & 1023) == 0 ? timeUp() :
+			stopFlag.load(memory_order_relaxed)){
+		return 0;
+	}
+	uint64_t moves = position.validMoves();
+	if (moves == 0){
+		if (passed){
+			return scoreDisc * position.getDiscDifference();
+		}
+		return -search(position.pass(), depth, -beta, -alpha, true);
+	}
+	if (depth == 0){
+		return evaluate(position);
+	}
+
+	// Cut off or narrow the window with the result of an earlier search
+	uint64_t key = position.hash();
+	int hashDepth;
+	int hashScore;
+	ReversiHashTable::BOUND_t hashBound;
+	int hashMove = ReversiHashTable::noMove;
+	bool found = hashTable->probe(key, hashDepth, hashScore, hashBound,
+			hashMove);
+	if (persistentCache && depth >= cacheMinDepth &&
+			(!found || hashDepth < depth)){
+		// Look for a deeper result of an earlier run on disk
+		int cacheDepth;
+		int cacheScore;
+		ReversiHashTable::BOUND_t cacheBound;
+		int cacheMove;
+		if (persistentCache->probe(position, cacheDepth, cacheScore,
+				cacheBound, cacheMove) && (!found || cacheDepth > hashDepth)){
+			found = true;
+			hashDepth = cacheDepth;
+			hashScore = cacheScore;
+			hashBound = cacheBound;
+			hashMove = cacheMove;
+		}
+	}
+	if (found && hashDepth >= depth){
+		if (hashBound == ReversiHashTable::BOUND_EXACT ||
+				(hashBound == ReversiHashTable::BOUND_LOWER &&
+						hashScore >= beta) ||
+				(hashBound == ReversiHashTable::BOUND_UPPER &&
+						hashScore <= alpha)){
+			return hashScore;
+		}
+	}
+
+	int probCutScore;
+	if (probCut && probCutNode(position, depth, alpha, beta, probCutScore)){
+		return probCutScore;
+	}
+
+	// Order the moves: best move of the hash table first, then the moves
+	// leaving the opponent the fewest replies
+	int moveList[32];
+	int orderKeys[32];
+	int moveCount = 0;
+	while (moves){
+		int index = __builtin_ctzll(moves);
+		moves &= moves - 1;
+		int orderKey;
+		if (index == hashMove){
+			orderKey = -1000;
+		}
+		else if (depth > 2){
+			orderKey = __builtin_popcountll(position.play(index).validMoves());
+		}
+		else{
+			orderKey = 0;
+		}
+		int slot = moveCount++;
+		while (slot > 0 && orderKeys[slot - 1] > orderKey){
+			moveList[slot] = moveList[slot - 1];
+			orderKeys[slot] = orderKeys[slot - 1];
+			slot--;
+		}
+		moveList[slot] = index;
+		orderKeys[slot] = orderKey;
+	}
+
+	int originalAlpha = alpha;
+	int bestScore = -scoreInfinity;
+	int bestMove = ReversiHashTable::noMove;
+	for (int moveIndex = 0; moveIndex < moveCount; moveIndex++){
+		int index = moveList[moveIndex];
+		int score = -search(position.play(index), depth - 1, -beta, -alpha,
+				false);
+		if (stopFlag.load(memory_order_relaxed)){
+			return 0;
+		}
+		if (score > bestScore){
+			bestScore = score;
+			bestMove = index;
+			if (score > alpha){
+				alpha = score;
+				if (alpha >= beta){
+					break;
+				}
+			}
+		}
+	}
+
+	ReversiHashTable::BOUND_t bound = ReversiHashTable::BOUND_EXACT;
+	if (bestScore <= originalAlpha){
+		bound = ReversiHashTable::BOUND_UPPER;
+	}
+	else if (bestScore >= beta){
+		bound = ReversiHashTable::BOUND_LOWER;
+	}
+	hashTable->store(key, depth, bestScore, bound, bestMove);
+	if (persistentCache && depth >= cacheMinDepth){
+		persistentCache->store(position, depth, bestScore, bound, bestMove);
+	}
+	return bestScore;
+}
+
+/**
+ * Tries to cut a node with Multi-ProbCut. For each check the deep score
+ * is predicted from a shallow search with a null window: if even the
+ * prediction lowered by probCutSigmas standard deviations reaches beta
+ * the node fails high, if even the raised prediction stays at or below
+ * alpha it fails low. Searches that reach the end of the game are not
+ * cut, their scores are exact
+ * \param const ReversiPosition& position	: [IN] position to search
+ * \param int depth			: [IN] remaining depth in moves
+ * \param int alpha			: [IN] lower limit of the search window
+ * \param int beta			: [IN] upper limit of the search window
+ * \param int& score		: [OUT] alpha or beta if the node is cut
+ * \return true if the node is cut
+ */
+bool ReversiEngine::probCutNode(const ReversiPosition& position, int depth,
+		int alpha, int beta, int& score)
+{
+	int empties = position.getEmptyCount();
+	if (depth < ReversiProbCut::minDepth || depth > ReversiProbCut::maxDepth
+			|| depth >= empties){
+		return false;
+	}
+	for (int check = 0; check < ReversiProbCut::checkCount; check++){
+		double a;
+		double b;
+		double sigma;
+		if (!probCut->getParameters(empties, depth, check, a, b, sigma)){
+			continue;
+		}
+		int shallowDepth = ReversiProbCut::getCheckDepth(depth, check);
+		double margin = probCutSigmas * sigma;
+		double high = (beta + margin - b) / a;
+		if (high < scoreInfinity - 1){
+			int bound = (int)ceil(high);
+			if (search(position, shallowDepth, bound - 1, bound, false) >=
+					bound){
+				score = beta;
+				return true;
+			}
+		}
+		double low = (alpha - margin - b) / a;
+		if (low > -scoreInfinity + 1){
+			int bound = (int)floor(low);
+			if (search(position, shallowDepth, bound, bound + 1, false) <=
+					bound){
+				score = alpha;
+				return true;
+			}
+		}
+		if (stopFlag.load(memory_order_relaxed)){
+			return false;
+		}
+	}
+	return false;
+}
+
+/**
+ * Iterative deepening search of a position. After every completed
+ * iteration the result member is updated. Stops at the deadlines,
+ * when cancelled, when maxDepth or when the game end has been searched
+ * \param const ReversiPosition& position	: [IN] position to search
+ * \param int maxDepth		: [IN] depth of the last iteration
+ */
+void ReversiEngine::iterate(const ReversiPosition& position, int maxDepth)
+{
+	uint64_t moves = position.validMoves();
+	int empties = position.getEmptyCount();
+	nodes = 0;
+	{
+		lock_guard<mutex> lock(resultMutex);
+		result.move = moves ? __builtin_ctzll(moves) : -1;
+		result.score = 0;
+		result.depth = 0;
+		result.nodes = 0;
+		result.reply = -1;
+	}
+	if (moves == 0){
+		return;
+	}
+
+	int stable = 0;
+	if (maxDepth > empties){
+		maxDepth = empties;
+	}
+	for (int depth = 1; depth <= maxDepth; depth++){
+		int alpha = -scoreInfinity;
+		int bestMove = -1;
+		int moveList[32];
+		int moveCount = 0;
+		{
+			lock_guard<mutex> lock(resultMutex);
+			moveList[moveCount++] = result.move;	// last best move first
+		}
+		for (uint64_t rest = moves & ~(1ULL << moveList[0]); rest;
+				rest &= rest - 1){
+			moveList[moveCount++] = __builtin_ctzll(rest);
+		}
+		for (int moveIndex = 0; moveIndex < moveCount; moveIndex++){
+			int index = moveList[moveIndex];
+			int score = -search(position.play(index), depth - 1,
+					-scoreInfinity, -alpha, false);
+			if (stopFlag.load(memory_order_relaxed)){
+				break;
+			}
+			if (score > alpha){
+				alpha = score;
+				bestMove = index;
+			}
+		}
+		if (stopFlag.load(memory_order_relaxed)){
+			break;
+		}
+
+		// The best reply is the best move stored for the position after
+		// the best move
+		int replyDepth;
+		int replyScore;
+		ReversiHashTable::BOUND_t replyBound;
+		int reply = ReversiHashTable::noMove;
+		hashTable->probe(position.play(bestMove).hash(), replyDepth,
+				replyScore, replyBound, reply);
+		{
+			lock_guard<mutex> lock(resultMutex);
+			stable = bestMove == result.move ? stable + 1 : 0;
+			result.move = bestMove;
+			result.score = alpha;
+			result.depth = depth;
+			result.nodes = nodes;
+			result.reply = reply == ReversiHashTable::noMove ? -1 : reply;
+		}
+
+		int64_t now = nowMs();
+		if (now >= softDeadline.load() ||
+				(stable >= stableIterations && now >= stableDeadline.load())){
+			break;
+		}
+	}
+	lock_guard<mutex> lock(resultMutex);
+	result.nodes = nodes;
+}
+
+/**
+ * Sets the deadlines of a search that may use budgetMs milliseconds
+ * from startMs on. No new iteration is started after half of the time
+ * as it would most likely not finish, and a stable best move ends the
+ * search after a fifth of the time
+ * \param int64_t startMs	: [IN] start of the thinking time
+ * \param int budgetMs		: [IN] thinking time in milliseconds
+ */
+void ReversiEngine::setDeadlines(int64_t startMs, int budgetMs)
+{
+	stableDeadline.store(startMs + budgetMs / 5);
+	softDeadline.store(startMs + budgetMs / 2);
+	hardDeadline.store(startMs + budgetMs);
+}
+
+/**
+ * Computes the thinking time for the next move from the per-move
+ * limit and the game clock. The clock is spread evenly over the moves
+ * the engine still has to make
+ * \param const ReversiPosition& position	: [IN] position to move in
+ * \return thinking time in milliseconds
+ */
+int ReversiEngine::moveBudget(const ReversiPosition& position) const
+{
+	int movesLeft = (position.getEmptyCount() + 1) / 2;
+	int budget = clockMs / (movesLeft > 0 ? movesLeft : 1);
+	if (budget > moveTimeMs){
+		budget = moveTimeMs;
+	}
+	return budget > 10 ? budget : 10;
+}
+
+/**
+ * Finds the move to play. If the position is the one pondered on, the
+ * pondering search is taken over and only runs for what is left of
+ * the thinking time, else it is cancelled and a new search is started
+ * The time used is taken off the game clock
+ * \param ReversiBoard& board	: [IN] current board
+ * \param bool player1			: [IN] true if the engine is PLAYER1
+ * \return result of the search, move -1 if the engine has to pass
+ */
+ReversiEngine::SearchResult ReversiEngine::findMove(ReversiBoard& board,
+		bool player1)
+{
+	int64_t startMs = nowMs();
+	ReversiPosition position = board.getPosition(player1);
+	int budget = moveBudget(position);
+
+	if (ponderThread.joinable() && position == ponderPosition){
+		// Ponder hit: the search has been running since ponderStartMs, so
+		// it gets the deadlines it would have had if it had started then.
+		// Only the time from now on is charged to the clock
+		setDeadlines(ponderStartMs, budget);
+		ponderThread.join();
+	}
+	else{
+		stopPondering();
+		stopFlag.store(false);
+		setDeadlines(startMs, budget);
+		hashTable->newSearch();
+		iterate(position, 64);
+	}
+
+	clockMs -= (int)(nowMs() - startMs);
+	lock_guard<mutex> lock(resultMutex);
+	return result;
+}
+
+/**
+ * Searches a position, independent of the game clock and of pondering.
+ * With a node limit the result only depends on the position and the
+ * hash table, not on the speed of the machine
+ * \param const ReversiPosition& position	: [IN] position to search
+ * \param int maxDepth		: [IN] maximum depth in moves
+ * \param int budgetMs		: [IN] thinking time in milliseconds
+ * \param uint64_t maxNodes	: [IN] maximum number of nodes, 0 for no
+ * 							limit
+ * \return result of the search, move -1 if the side has to pass
+ */
+ReversiEngine::SearchResult ReversiEngine::searchPosition(
+		const ReversiPosition& position, int maxDepth, int budgetMs,
+		uint64_t maxNodes)
+{
+	stopPondering();
+	stopFlag.store(false);
+	setDeadlines(nowMs(), budgetMs);
+	hashTable->newSearch();
+	nodeLimit = maxNodes;
+	iterate(position, maxDepth);
+	nodeLimit = 0;
+	lock_guard<mutex> lock(resultMutex);
+	return result;
+}
+
+/**
+ * Searches a position full-window to a fixed depth, without iterative
+ * deepening and without time limit
+ * \param const ReversiPosition& position	: [IN] position to search
+ * \param int depth		: [IN] depth in moves, 0 for the static evaluation
+ * \return score in 1/100 discs for the side to move
+ */
+int ReversiEngine::scorePosition(const ReversiPosition& position, int depth)
+{
+	stopPondering();
+	stopFlag.store(false);
+	setDeadlines(nowMs(), numeric_limits<int>::max() / 2);
+	return search(position, depth, -scoreInfinity, scoreInfinity, false);
+}
+
+/**
+ * Switches the selective search on or off. The parameters have to
+ * stay valid while the engine uses them. Scores in the hash table found
+ * with another setting are kept, as they are still good estimates
+ * \param const ReversiProbCut* probCut	: [IN] parameters or nullptr for
+ * 							full-width search
+ * \param double confidence	: [IN] probability of a correct cut, higher
+ * 							values cut less and search slower
+ */
+void ReversiEngine::setProbCut(const ReversiProbCut* probCut,
+		double confidence)
+{
+	stopPondering();
+	this->probCut = probCut;
+	probCutSigmas = ReversiProbCut::confidenceToSigmas(confidence);
+}
+
+/**
+ * Sets a flag that cancels the running and all later searches while it is
+ * set. Unlike stopPondering it may be set from any thread at any time,
+ * also just before a search starts. The flag has to stay valid while the
+ * engine uses it
+ * \param const std::atomic<bool>* signal	: [IN] flag or nullptr
+ */
+void ReversiEngine::setCancelSignal(const atomic<bool>* signal)
+{
+	stopPondering();
+	cancelSignal = signal;
+}
+
+/**
+ * Sets the cache on disk used next to the hash table. The cache has to
+ * stay open while the engine uses it
+ * \param ReversiPersistentCache* cache	: [IN] open cache or nullptr
+ */
+void ReversiEngine::setPersistentCache(ReversiPersistentCache* cache)
+{
+	stopPondering();
+	persistentCache = cache;
+}
+
+/**
+ * Starts pondering in the background after the engine has moved. The
+ * expected reply of the opponent is played and the resulting position
+ * is searched until findMove or stopPondering is called. If the reply
+ * is unknown, the reply with the best static evaluation is expected
+ * \param ReversiBoard& board	: [IN] board after the engine's move
+ * \param bool player1			: [IN] true if the engine is PLAYER1
+ * \param int reply				: [IN] expected reply or -1 if unknown
+ */
+void ReversiEngine::startPondering(ReversiBoard& board, bool player1,
+		int reply)
+{
+	stopPondering();
+	ReversiPosition position = board.getPosition(!player1);
+	uint64_t replies = position.validMoves();
+	if (replies == 0){
+		// The opponent has to pass, the engine moves again
+		ponderPosition = position.pass();
+	}
+	else{
+		if (reply < 0 || !(replies & (1ULL << reply))){
+			int bestScore = numeric_limits<int>::max();
+			for (uint64_t rest = replies; rest; rest &= rest - 1){
+				int index = __builtin_ctzll(rest);
+				int score = evaluate(position.play(index));
+				if (score < bestScore){
+					bestScore = score;
+					reply = index;
+				}
+			}
+		}
+		ponderPosition = position.play(reply);
+	}
+	if (ponderPosition.validMoves() == 0){
+		return;
+	}
+
+	ponderStartMs = nowMs();
+	stopFlag.store(false);
+	setDeadlines(ponderStartMs, numeric_limits<int>::max() / 2);
+	hashTable->newSearch();
+	ponderThread = thread(&ReversiEngine::iterate, this, ponderPosition, 64);
+}
+
+/**
+ * Cancels pondering and waits for the background thread to finish
+ */
+void ReversiEngine::stopPondering()
+{
+	if (ponderThread.joinable()){
+		stopFlag.store(true);
+		ponderThread.join();
+	}
+}
+
+/**
+ * Returns the thinking time left on the game clock
+ * \return time left in milliseconds
+ */
+int ReversiEngine::getClockMs() const
+{
+	return clockMs;
+}
+
+/**
+ * Destructor of class ReversiEngine, stops pondering
+ */
+ReversiEngine::~ReversiEngine()
+{
+	stopPondering();
+}
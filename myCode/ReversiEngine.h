@@ -0,0 +1,340 @@
+/*
+ * ReversiEngine.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIENGINE_H_
+#define REVERSIENGINE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "ReversiBoard.h"
+#include "ReversiHashTable.h"
+#include "ReversiPersistentCache.h"
+#include "ReversiPosition.h"
+#include "ReversiProbCut.h"
+
+class ReversiEngine
+{
+public:
+	/**
+	 * Result of a search: best move as board index (-1 for a pass), its
+	 * score in 1/100 discs for the side to move, the depth of the last
+	 * completed iteration, the searched nodes and the expected reply of
+	 * the opponent (-1 if unknown)
+	 */
+	struct SearchResult{
+		int move;
+		int score;
+		int depth;
+		uint64_t nodes;
+		int reply;
+	};
+
+	/**
+	 * Score of one disc, final positions are scored as disc difference
+	 * times scoreDisc
+	 */
+	static const int scoreDisc = 100;
+
+private:
+	/**
+	 * Score larger than any real score, used as search window limit
+	 */
+	static const int scoreInfinity = 30000;
+
+	/**
+	 * Smallest depth stored in and looked up in the persistent cache,
+	 * shallower searches cost less than finding the canonical position
+	 */
+	static const int cacheMinDepth = 4;
+
+	/**
+	 * Number of iterations with the same best move after which the best
+	 * move counts as stable and the search may stop early
+	 */
+	static const int stableIterations = 3;
+
+	/**
+	 * Cache of positions already searched, shared between the searches of
+	 * consecutive moves and the pondering search. nullptr for an engine
+	 * that uses a table shared with other engines
+	 */
+	std::unique_ptr<ReversiHashTable> ownHashTable;
+
+	/**
+	 * Hash table used by the search, the own one or one shared with other
+	 * engines
+	 */
+	ReversiHashTable* hashTable;
+
+	/**
+	 * Maximum thinking time for a single move in milliseconds
+	 */
+	int moveTimeMs;
+
+	/**
+	 * Thinking time left on the engine's game clock in milliseconds
+	 */
+	int clockMs;
+
+	/**
+	 * Cache on disk shared with other runs and processes, nullptr if
+	 * none is used
+	 */
+	ReversiPersistentCache* persistentCache;
+
+	/**
+	 * Parameters of the selective search, nullptr for full-width search
+	 */
+	const ReversiProbCut* probCut;
+
+	/**
+	 * Number of standard deviations a predicted score has to lie outside
+	 * the search window to cut
+	 */
+	double probCutSigmas;
+
+	/**
+	 * Nodes searched in the running search
+	 */
+	uint64_t nodes;
+
+	/**
+	 * Number of nodes after which the running search is aborted, 0 for
+	 * no limit
+	 */
+	uint64_t nodeLimit;
+
+	/**
+	 * Set to cancel the running search as soon as possible
+	 */
+	std::atomic<bool> stopFlag;
+
+	/**
+	 * Flag of the owner that cancels every search while it is set,
+	 * nullptr if there is none
+	 */
+	const std::atomic<bool>* cancelSignal;
+
+	/**
+	 * Time after which the running search is aborted
+	 */
+	std::atomic<int64_t> hardDeadline;
+
+	/**
+	 * Time after which no new iteration is started
+	 */
+	std::atomic<int64_t> softDeadline;
+
+	/**
+	 * Time after which the search stops once the best move is stable
+	 */
+	std::atomic<int64_t> stableDeadline;
+
+	/**
+	 * Background thread searching the position expected after the
+	 * opponent's reply while the opponent is thinking
+	 */
+	std::thread ponderThread;
+
+	/**
+	 * Position pondered on, the engine to move
+	 */
+	ReversiPosition ponderPosition;
+
+	/**
+	 * Time at which pondering started
+	 */
+	int64_t ponderStartMs;
+
+	/**
+	 * Result of the last completed iteration of the running search,
+	 * guarded by resultMutex as it is written by the pondering thread
+	 */
+	SearchResult result;
+
+	/**
+	 * Guards result
+	 */
+	std::mutex resultMutex;
+
+	/**
+	 * Returns a monotonic time stamp
+	 * \return milliseconds since an arbitrary fixed point
+	 */
+	static int64_t nowMs();
+
+	/**
+	 * Static evaluation of a position from the view of the side to move,
+	 * based on square weights and mobility
+	 * \param const ReversiPosition& position	: [IN] position to evaluate
+	 * \return score in 1/100 discs
+	 */
+	static int evaluate(const ReversiPosition& position);
+
+	/**
+	 * Checks if the running search has to be aborted
+	 * \return true if cancelled or out of time
+	 */
+	bool timeUp();
+
+	/**
+	 * Alpha-beta search in negamax form with the hash table
+	 * \param const ReversiPosition& position	: [IN] position to search
+	 * \param int depth			: [IN] remaining depth in moves
+	 * \param int alpha			: [IN] lower limit of the search window
+	 * \param int beta			: [IN] upper limit of the search window
+	 * \param bool passed		: [IN] true if the last move was a pass
+	 * \return score of the position, meaningless if the search was aborted
+	 */
+	int search(const ReversiPosition& position, int depth, int alpha,
+			int beta, bool passed);
+
+	/**
+	 * Tries to cut a node with Multi-ProbCut: shallow searches predict if
+	 * the deep search would fail high or low
+	 * \param const ReversiPosition& position	: [IN] position to search
+	 * \param int depth			: [IN] remaining depth in moves
+	 * \param int alpha			: [IN] lower limit of the search window
+	 * \param int beta			: [IN] upper limit of the search window
+	 * \param int& score		: [OUT] alpha or beta if the node is cut
+	 * \return true if the node is cut
+	 */
+	bool probCutNode(const ReversiPosition& position, int depth, int alpha,
+			int beta, int& score);
+
+	/**
+	 * Iterative deepening search of a position. After every completed
+	 * iteration the result member is updated. Stops at the deadlines,
+	 * when cancelled, when maxDepth or when the game end has been searched
+	 * \param const ReversiPosition& position	: [IN] position to search
+	 * \param int maxDepth		: [IN] depth of the last iteration
+	 */
+	void iterate(const ReversiPosition& position, int maxDepth);
+
+	/**
+	 * Sets the deadlines of a search that may use budgetMs milliseconds
+	 * from startMs on
+	 * \param int64_t startMs	: [IN] start of the thinking time
+	 * \param int budgetMs		: [IN] thinking time in milliseconds
+	 */
+	void setDeadlines(int64_t startMs, int budgetMs);
+
+	/**
+	 * Computes the thinking time for the next move from the per-move
+	 * limit and the game clock
+	 * \param const ReversiPosition& position	: [IN] position to move in
+	 * \return thinking time in milliseconds
+	 */
+	int moveBudget(const ReversiPosition& position) const;
+
+public:
+	/**
+	 * Constructor of class ReversiEngine with its time control
+	 * \param int moveTimeMs	: [IN] maximum thinking time per move
+	 * \param int gameTimeMs	: [IN] thinking time for the whole game
+	 * \param int hashSizeMb	: [IN] size of the hash table in megabytes
+	 */
+	ReversiEngine(int moveTimeMs, int gameTimeMs, int hashSizeMb = 64);
+
+	/**
+	 * Constructor of class ReversiEngine for searches without time
+	 * control that use a hash table shared with other engines, no own
+	 * table is allocated. The table has to stay valid while the engine
+	 * uses it
+	 * \param ReversiHashTable& sharedTable	: [IN] table to use
+	 */
+	ReversiEngine(ReversiHashTable& sharedTable);
+
+	/**
+	 * Finds the move to play. If the position is the one pondered on, the
+	 * pondering search is taken over and only runs for what is left of
+	 * the thinking time, else it is cancelled and a new search is started
+	 * The time used is taken off the game clock
+	 * \param ReversiBoard& board	: [IN] current board
+	 * \param bool player1			: [IN] true if the engine is PLAYER1
+	 * \return result of the search, move -1 if the engine has to pass
+	 */
+	SearchResult findMove(ReversiBoard& board, bool player1);
+
+	/**
+	 * Searches a position, independent of the game clock and of pondering
+	 * \param const ReversiPosition& position	: [IN] position to search
+	 * \param int maxDepth		: [IN] maximum depth in moves
+	 * \param int budgetMs		: [IN] thinking time in milliseconds
+	 * \param uint64_t maxNodes	: [IN] maximum number of nodes, 0 for no
+	 * 							limit
+	 * \return result of the search, move -1 if the side has to pass
+	 */
+	SearchResult searchPosition(const ReversiPosition& position,
+			int maxDepth, int budgetMs, uint64_t maxNodes = 0);
+
+	/**
+	 * Searches a position full-window to a fixed depth, without iterative
+	 * deepening and without time limit
+	 * \param const ReversiPosition& position	: [IN] position to search
+	 * \param int depth		: [IN] depth in moves, 0 for the static evaluation
+	 * \return score in 1/100 discs for the side to move
+	 */
+	int scorePosition(const ReversiPosition& position, int depth);
+
+	/**
+	 * Switches the selective search on or off. The parameters have to
+	 * stay valid while the engine uses them
+	 * \param const ReversiProbCut* probCut	: [IN] parameters or nullptr for
+	 * 							full-width search
+	 * \param double confidence	: [IN] probability of a correct cut, higher
+	 * 							values cut less and search slower
+	 */
+	void setProbCut(const ReversiProbCut* probCut, double confidence);
+
+	/**
+	 * Sets a flag that cancels the running and all later searches while
+	 * it is set. Unlike stopPondering it may be set from any thread at any
+	 * time, also just before a search starts. The flag has to stay valid
+	 * while the engine uses it
+	 * \param const std::atomic<bool>* signal	: [IN] flag or nullptr
+	 */
+	void setCancelSignal(const std::atomic<bool>* signal);
+
+	/**
+	 * Sets the cache on disk used next to the hash table. The cache has to
+	 * stay open while the engine uses it
+	 * \param ReversiPersistentCache* cache	: [IN] open cache or nullptr
+	 */
+	void setPersistentCache(ReversiPersistentCache* cache);
+
+	/**
+	 * Starts pondering in the background after the engine has moved. The
+	 * expected reply of the opponent is played and the resulting position
+	 * is searched until findMove or stopPondering is called
+	 * \param ReversiBoard& board	: [IN] board after the engine's move
+	 * \param bool player1			: [IN] true if the engine is PLAYER1
+	 * \param int reply				: [IN] expected reply or -1 if unknown
+	 */
+	void startPondering(ReversiBoard& board, bool player1, int reply);
+
+	/**
+	 * Cancels pondering and waits for the background thread to finish
+	 */
+	void stopPondering();
+
+	/**
+	 * Returns the thinking time left on the game clock
+	 * \return time left in milliseconds
+	 */
+	int getClockMs() const;
+
+	/**
+	 * Destructor of class ReversiEngine, stops pondering
+	 */
+	virtual ~ReversiEngine();
+};
+
+#endif /* REVERSIENGINE_H_ */
@@ -0,0 +1,437 @@
+/*
+ * ReversiEnumerator.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include "ReversiBoard.h"
+#include "ReversiEnumerator.h"
+using namespace std;
+
+/**
+ * Identification of a ply file
+ */
+static const char plyMagic[8] = {'R', 'V', 'P', 'L', 'Y', 'S', 'E', 'T'};
+static const uint32_t plyVersion = 1;
+
+/**
+ * Positions of the last ply expanded by one task
+ */
+static const size_t chunkPositions = 1 << 16;
+
+/**
+ * Positions a task collects per partition before it appends them to the
+ * partition file
+ */
+static const size_t spillPositions = 4096;
+
+/**
+ * Largest number of partitions, each one is an open file while a ply is
+ * expanded
+ */
+static const int maxPartitionBits = 8;
+
+/**
+ * Number of hash bits used each time a partition is split again
+ */
+static const int splitBits = 4;
+
+/**
+ * Expected positions generated per position of the last ply, used to
+ * choose the number of partitions
+ */
+static const int expectedBranching = 12;
+
+/**
+ * Orders positions by their discs and the color to move, so equal
+ * positions are adjacent
+ * \param const ReversiPosition& first	: [IN] first position
+ * \param const ReversiPosition& second	: [IN] second position
+ * \return true if first comes before second
+ */
+static bool positionLess(const ReversiPosition& first,
+		const ReversiPosition& second)
+{
+	if (first.getPlayer() != second.getPlayer()){
+		return first.getPlayer() < second.getPlayer();
+	}
+	if (first.getOpponent() != second.getOpponent()){
+		return first.getOpponent() < second.getOpponent();
+	}
+	return first.isPlayer1ToMove() < second.isPlayer1ToMove();
+}
+
+/**
+ * Runs a function for every number from 0 to count - 1 as tasks of a
+ * pool and waits until all have returned
+ * \param ReversiThreadPool& pool	: [IN] pool to run the tasks on
+ * \param size_t count				: [IN] number of tasks
+ * \param const std::function<void(size_t)>& function	: [IN] task body
+ */
+static void runAll(ReversiThreadPool& pool, size_t count,
+		const function<void(size_t)>& function)
+{
+	mutex doneMutex;
+	condition_variable allDone;
+	size_t pending = count;
+	for (size_t index = 0; index < count; index++){
+		pool.submit([&, index]{
+			function(index);
+			lock_guard<mutex> lock(doneMutex);
+			if (--pending == 0){
+				allDone.notify_all();
+			}
+		});
+	}
+	unique_lock<mutex> lock(doneMutex);
+	allDone.wait(lock, [&]{ return pending == 0; });
+}
+
+/**
+ * Removes the duplicates of a partition file and appends the different
+ * positions to the output. If the partition has more positions than fit
+ * into memory, it is split by the next bits of the hash into partition
+ * files that are handled one after the other. The partition file is
+ * removed
+ * \param const std::string& path	: [IN] path of the partition file
+ * \param int shift		: [IN] the hash bits below this bit are not yet used
+ * 						for partitioning
+ * \param size_t maxPositions	: [IN] positions that fit into memory
+ * \param std::ofstream& output	: [IN] file the positions are appended to
+ * \param uint64_t& uniqueCount	: [IN,OUT] counter of different positions
+ * \return false if a file could not be read or written
+ */
+static bool dedupe(const string& path, int shift, size_t maxPositions,
+		ofstream& output, uint64_t& uniqueCount)
+{
+	ifstream input(path.c_str(), ios::binary | ios::ate);
+	if (!input){
+		cout << "Cannot open " << path << endl;
+		return false;
+	}
+	size_t count = (size_t)input.tellg() / sizeof(ReversiPosition);
+	input.seekg(0);
+
+	if (count > maxPositions && shift >= splitBits){
+		shift -= splitBits;
+		vector<unique_ptr<ofstream>> parts;
+		vector<vector<ReversiPosition>> buffers(1 << splitBits);
+		for (int part = 0; part < 1 << splitBits; part++){
+			parts.emplace_back(new ofstream((path + "." + to_string(part)).c_str(),
+					ios::binary));
+			buffers[part].reserve(spillPositions);
+		}
+		vector<ReversiPosition> block(spillPositions);
+		while (count > 0){
+			size_t blockSize = min(count, spillPositions);
+			input.read((char*)block.data(), blockSize *
+					sizeof(ReversiPosition));
+			count -= blockSize;
+			for (size_t index = 0; index < blockSize; index++){
+				int part = (block[index].hash() >> shift) &
+						((1 << splitBits) - 1);
+				buffers[part].push_back(block[index]);
+				if (buffers[part].size() == spillPositions){
+					parts[part]->write((const char*)buffers[part].data(),
+							spillPositions * sizeof(ReversiPosition));
+					buffers[part].clear();
+				}
+			}
+		}
+		bool written = (bool)input;
+		for (int part = 0; part < 1 << splitBits; part++){
+			parts[part]->write((const char*)buffers[part].data(),
+					buffers[part].size() * sizeof(ReversiPosition));
+			parts[part]->close();
+			written = written && *parts[part];
+		}
+		input.close();
+		remove(path.c_str());
+		for (int part = 0; part < 1 << splitBits; part++){
+			string partPath = path + "." + to_string(part);
+			if (written){
+				written = dedupe(partPath, shift, maxPositions, output,
+						uniqueCount);
+			}
+			remove(partPath.c_str());
+		}
+		return written;
+	}
+
+	vector<ReversiPosition> positions(count);
+	input.read((char*)positions.data(), count * sizeof(ReversiPosition));
+	input.close();
+	remove(path.c_str());
+	if (!input){
+		cout << "Cannot read " << path << endl;
+		return false;
+	}
+	sort(positions.begin(), positions.end(), positionLess);
+	positions.erase(unique(positions.begin(), positions.end()),
+			positions.end());
+	output.write((const char*)positions.data(),
+			positions.size() * sizeof(ReversiPosition));
+	uniqueCount += positions.size();
+	return (bool)output;
+}
+
+/**
+ * Returns the path of the file of a ply
+ * \param const std::string& directory	: [IN] directory of the files
+ * \param int ply	: [IN] number of moves played
+ * \return path of the file
+ */
+string ReversiEnumerator::plyPath(const string& directory, int ply)
+{
+	return directory + "/ply" + (ply < 10 ? "0" : "") + to_string(ply) +
+			".bin";
+}
+
+/**
+ * Writes the positions of a ply to its file
+ * \param const std::string& path	: [IN] path of the file
+ * \param int ply	: [IN] number of moves played
+ * \param const std::vector<ReversiPosition>& positions	: [IN] sorted
+ * 									canonical positions
+ * \return false if the file could not be written
+ */
+bool ReversiEnumerator::writePly(const string& path, int ply,
+		const vector<ReversiPosition>& positions)
+{
+	Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, plyMagic, sizeof(header.magic));
+	header.version = plyVersion;
+	header.ply = ply;
+	header.count = positions.size();
+	ofstream file(path.c_str(), ios::binary);
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)positions.data(),
+			positions.size() * sizeof(ReversiPosition));
+	file.close();
+	if (!file){
+		cout << "Cannot write " << path << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Computes the positions of a ply from the file of the ply before. The
+ * last ply is split into chunks expanded by the tasks of the pool, every
+ * task collects the new positions per partition and appends them to the
+ * partition files. Then every partition is made unique by its own task
+ * into a sorted file, and the sorted files are joined into the ply file
+ * \param ReversiThreadPool& pool		: [IN] pool for the expansion
+ * 										and the partitions
+ * \param const std::string& directory	: [IN] directory of the files
+ * \param int ply		: [IN] ply to compute
+ * \param int memoryMb	: [IN] memory for sorting in megabytes
+ * \param uint64_t& generated	: [OUT] positions generated before
+ * 								removing duplicates
+ * \param uint64_t& unique		: [OUT] different positions
+ * \return false if a file could not be read or written
+ */
+bool ReversiEnumerator::expand(ReversiThreadPool& pool,
+		const string& directory, int ply, int memoryMb, uint64_t& generated,
+		uint64_t& unique)
+{
+	string inputPath = plyPath(directory, ply - 1);
+	string path = plyPath(directory, ply);
+	Header header;
+	ifstream input(inputPath.c_str(), ios::binary);
+	if (!input.read((char*)&header, sizeof(header)) ||
+			memcmp(header.magic, plyMagic, sizeof(plyMagic)) != 0 ||
+			header.version != plyVersion){
+		cout << "Cannot read " << inputPath << endl;
+		return false;
+	}
+	input.close();
+
+	// Enough partitions that each one most likely fits into the memory of
+	// one thread, and at least one per thread
+	int threadCount = pool.getThreadCount();
+	size_t maxPositions = ((size_t)memoryMb << 20) / threadCount /
+			sizeof(ReversiPosition);
+	int partitionBits = 0;
+	while (partitionBits < maxPartitionBits &&
+			((1ULL << partitionBits) < (uint64_t)threadCount ||
+			header.count * expectedBranching >
+			(maxPositions << partitionBits) / 2)){
+		partitionBits++;
+	}
+	int partitionCount = 1 << partitionBits;
+	vector<unique_ptr<ofstream>> partitions;
+	vector<unique_ptr<mutex>> partitionMutexes;
+	for (int partition = 0; partition < partitionCount; partition++){
+		partitions.emplace_back(new ofstream((path + ".part" +
+				to_string(partition)).c_str(), ios::binary));
+		partitionMutexes.emplace_back(new mutex());
+	}
+
+	atomic<uint64_t> generatedCount(0);
+	atomic<bool> failed(false);
+	size_t chunkCount = (header.count + chunkPositions - 1) / chunkPositions;
+	runAll(pool, chunkCount, [&](size_t chunk){
+		size_t first = chunk * chunkPositions;
+		size_t count = min((size_t)header.count - first, chunkPositions);
+		vector<ReversiPosition> positions(count);
+		ifstream chunkInput(inputPath.c_str(), ios::binary);
+		chunkInput.seekg(sizeof(Header) + first * sizeof(ReversiPosition));
+		if (!chunkInput.read((char*)positions.data(),
+				count * sizeof(ReversiPosition))){
+			failed.store(true);
+			return;
+		}
+
+		vector<vector<ReversiPosition>> buffers(partitionCount);
+		auto spill = [&](int partition){
+			lock_guard<mutex> lock(*partitionMutexes[partition]);
+			partitions[partition]->write(
+					(const char*)buffers[partition].data(),
+					buffers[partition].size() * sizeof(ReversiPosition));
+			buffers[partition].clear();
+		};
+		uint64_t childCount = 0;
+		for (size_t index = 0; index < count; index++){
+			for (uint64_t moves = positions[index].validMoves(); moves;
+					moves &= moves - 1){
+				ReversiPosition child =
+						positions[index].play(__builtin_ctzll(moves));
+				if (child.validMoves() == 0 &&
+						child.pass().validMoves() != 0){
+					child = child.pass();
+				}
+				int symmetry;
+				child = child.canonical(symmetry);
+				int partition = partitionBits == 0 ? 0 :
+						(int)(child.hash() >> (64 - partitionBits));
+				buffers[partition].push_back(child);
+				if (buffers[partition].size() == spillPositions){
+					spill(partition);
+				}
+				childCount++;
+			}
+		}
+		for (int partition = 0; partition < partitionCount; partition++){
+			if (!buffers[partition].empty()){
+				spill(partition);
+			}
+		}
+		generatedCount += childCount;
+	});
+	bool written = !failed.load();
+	for (int partition = 0; partition < partitionCount; partition++){
+		partitions[partition]->close();
+		written = written && *partitions[partition];
+	}
+	partitions.clear();
+	if (!written){
+		cout << "Cannot write the partitions of " << path << endl;
+		return false;
+	}
+
+	vector<uint64_t> uniqueCounts(partitionCount, 0);
+	runAll(pool, partitionCount, [&](size_t partition){
+		string partitionPath = path + ".part" + to_string(partition);
+		ofstream sorted((path + ".sorted" + to_string(partition)).c_str(),
+				ios::binary);
+		if (!dedupe(partitionPath, 64 - partitionBits, maxPositions, sorted,
+				uniqueCounts[partition])){
+			failed.store(true);
+		}
+		sorted.close();
+		if (!sorted){
+			failed.store(true);
+		}
+	});
+
+	// Join the sorted partitions in the order of their hash bits
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, plyMagic, sizeof(header.magic));
+	header.version = plyVersion;
+	header.ply = ply;
+	string tempPath = path + ".tmp";
+	ofstream output(tempPath.c_str(), ios::binary);
+	output.write((const char*)&header, sizeof(header));
+	for (int partition = 0; partition < partitionCount; partition++){
+		string sortedPath = path + ".sorted" + to_string(partition);
+		ifstream sorted(sortedPath.c_str(), ios::binary);
+		if (uniqueCounts[partition] > 0){
+			output << sorted.rdbuf();
+		}
+		sorted.close();
+		remove(sortedPath.c_str());
+		header.count += uniqueCounts[partition];
+	}
+	output.seekp(0);
+	output.write((const char*)&header, sizeof(header));
+	output.close();
+	if (failed.load() || !output ||
+			rename(tempPath.c_str(), path.c_str()) != 0){
+		cout << "Cannot write " << path << endl;
+		remove(tempPath.c_str());
+		return false;
+	}
+	generated = generatedCount.load();
+	unique = header.count;
+	return true;
+}
+
+/**
+ * Enumerates the positions up to a ply and prints the number of
+ * different positions and the positions generated per second of every
+ * ply. Ply 0 is the start position of ReversiBoard
+ * \param const std::string& directory	: [IN] existing directory for
+ * 										the ply files
+ * \param int plies		: [IN] last ply to enumerate
+ * \param int threadCount	: [IN] number of threads
+ * \param int memoryMb	: [IN] memory for sorting in megabytes
+ * \return false if a file could not be read or written
+ */
+bool ReversiEnumerator::enumerate(const string& directory, int plies,
+		int threadCount, int memoryMb)
+{
+	ReversiBoard board;
+	int symmetry;
+	vector<ReversiPosition> start(1,
+			board.getPosition(true).canonical(symmetry));
+	if (!writePly(plyPath(directory, 0), 0, start)){
+		return false;
+	}
+	cout << fixed << setprecision(2);
+	cout << "Ply 0: 1 positions" << endl;
+
+	ReversiThreadPool pool(threadCount);
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	for (int ply = 1; ply <= plies; ply++){
+		chrono::steady_clock::time_point plyStart = chrono::steady_clock::now();
+		uint64_t generated;
+		uint64_t unique;
+		if (!expand(pool, directory, ply, memoryMb, generated, unique)){
+			return false;
+		}
+		double seconds = chrono::duration<double>(
+				chrono::steady_clock::now() - plyStart).count();
+		cout << "Ply " << ply << ": " << unique << " positions, " <<
+				generated << " generated in " << seconds << " s, " <<
+				(long)(generated / seconds) << " positions/s" << endl;
+	}
+	cout << "Enumerated " << plies << " plies with " << threadCount <<
+			" threads in " << chrono::duration<double>(
+			chrono::steady_clock::now() - begin).count() << " s" << endl;
+	return true;
+}
@@ -0,0 +1,97 @@
+/*
+ * ReversiEnumerator.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIENUMERATOR_H_
+#define REVERSIENUMERATOR_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ReversiPosition.h"
+#include "ReversiThreadPool.h"
+
+/**
+ * Enumerates all different positions reachable from the start position,
+ * ply by ply, with symmetric positions counted once. Each ply is written
+ * to its own file in a directory:
+ *
+ *   plyNN.bin: 64 byte header, then the canonical positions as 16 byte
+ *              records, grouped by hash partition and sorted within
+ *
+ * A side without valid moves passes, a pass is no ply. Positions where
+ * the game is over are kept in their ply but not expanded. The
+ * positions of the next ply are spread over partition files on disk by
+ * the top bits of their hash while the current ply is expanded in
+ * parallel, then every partition is sorted and made unique on its own.
+ * A partition larger than the memory given is split again by the next
+ * hash bits, so the number of positions per ply is only limited by the
+ * disk
+ */
+class ReversiEnumerator
+{
+	/**
+	 * First bytes of a ply file
+	 */
+	struct Header{
+		char magic[8];
+		uint32_t version;
+		uint32_t ply;
+		uint64_t count;
+		uint64_t reserved[5];
+	};
+
+	/**
+	 * Returns the path of the file of a ply
+	 * \param const std::string& directory	: [IN] directory of the files
+	 * \param int ply	: [IN] number of moves played
+	 * \return path of the file
+	 */
+	static std::string plyPath(const std::string& directory, int ply);
+
+	/**
+	 * Writes the positions of a ply to its file
+	 * \param const std::string& path	: [IN] path of the file
+	 * \param int ply	: [IN] number of moves played
+	 * \param const std::vector<ReversiPosition>& positions	: [IN] sorted
+	 * 									canonical positions
+	 * \return false if the file could not be written
+	 */
+	static bool writePly(const std::string& path, int ply,
+			const std::vector<ReversiPosition>& positions);
+
+	/**
+	 * Computes the positions of a ply from the file of the ply before
+	 * \param ReversiThreadPool& pool		: [IN] pool for the expansion
+	 * 										and the partitions
+	 * \param const std::string& directory	: [IN] directory of the files
+	 * \param int ply		: [IN] ply to compute
+	 * \param int memoryMb	: [IN] memory for sorting in megabytes
+	 * \param uint64_t& generated	: [OUT] positions generated before
+	 * 								removing duplicates
+	 * \param uint64_t& unique		: [OUT] different positions
+	 * \return false if a file could not be read or written
+	 */
+	static bool expand(ReversiThreadPool& pool, const std::string& directory,
+			int ply, int memoryMb, uint64_t& generated, uint64_t& unique);
+
+public:
+	/**
+	 * Enumerates the positions up to a ply and prints the number of
+	 * different positions and the positions generated per second of
+	 * every ply
+	 * \param const std::string& directory	: [IN] existing directory for
+	 * 										the ply files
+	 * \param int plies		: [IN] last ply to enumerate
+	 * \param int threadCount	: [IN] number of threads
+	 * \param int memoryMb	: [IN] memory for sorting in megabytes
+	 * \return false if a file could not be read or written
+	 */
+	static bool enumerate(const std::string& directory, int plies,
+			int threadCount, int memoryMb);
+};
+
+#endif /* REVERSIENUMERATOR_H_ */
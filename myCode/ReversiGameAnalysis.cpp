@@ -0,0 +1,244 @@
+/*
+ * ReversiGameAnalysis.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include "ReversiBoard.h"
+#include "ReversiEngine.h"
+#include "ReversiGameAnalysis.h"
+#include "ReversiGameFile.h"
+using namespace std;
+
+/**
+ * Losses in 1/100 discs from which a move is marked as inaccuracy (?!),
+ * mistake (?) and blunder (??)
+ */
+static const int inaccuracyLoss = 2 * ReversiEngine::scoreDisc;
+static const int mistakeLoss = 4 * ReversiEngine::scoreDisc;
+static const int blunderLoss = 8 * ReversiEngine::scoreDisc;
+
+/**
+ * Formats a score in 1/100 discs as discs with sign
+ * \param int score	: [IN] score in 1/100 discs
+ * \return text like +2.50
+ */
+static string formatScore(int score)
+{
+	stringstream text;
+	text << (score >= 0 ? "+" : "-") << fixed << setprecision(2) <<
+			abs(score) / (double)ReversiEngine::scoreDisc;
+	return text.str();
+}
+
+/**
+ * Constructor of class ReversiGameAnalysis
+ * \param int threadCount	: [IN] number of threads
+ * \param int depth			: [IN] depth of the searches in moves
+ * \param int exactEmpties	: [IN] most empty fields of a position that is
+ * 							solved exactly
+ * \param int hashSizeMb	: [IN] size of each hash table in megabytes
+ */
+ReversiGameAnalysis::ReversiGameAnalysis(int threadCount, int depth,
+		int exactEmpties, int hashSizeMb):
+		pool(threadCount), hashTable(hashSizeMb), solver(pool, hashSizeMb),
+		depth(depth), exactEmpties(exactEmpties)
+{
+}
+
+/**
+ * Grades one move. A position with few empty fields is solved, the move
+ * played only needs its own solve if it is not the best move. Otherwise
+ * every valid move is searched with a full window to the same depth, so
+ * the score of the move played comes from the same search as the best
+ * score and the loss is not an artifact of different depths
+ * \param MoveGrade& grade	: [IN,OUT] position and move played in,
+ * 							scores and best move out
+ */
+void ReversiGameAnalysis::gradeMove(MoveGrade& grade)
+{
+	const ReversiPosition& position = grade.position;
+	if (position.getEmptyCount() <= exactEmpties){
+		ReversiSolver::Result best = solver.solve(position);
+		grade.bestMove = best.move;
+		grade.bestScore = best.score * ReversiEngine::scoreDisc;
+		grade.playedScore = grade.move == best.move ? grade.bestScore :
+				-solver.solve(position.play(grade.move)).score *
+				ReversiEngine::scoreDisc;
+		grade.exact = true;
+		return;
+	}
+
+	ReversiEngine engine(hashTable);
+	grade.bestMove = -1;
+	for (uint64_t moves = position.validMoves(); moves; moves &= moves - 1){
+		int move = __builtin_ctzll(moves);
+		int score = -engine.scorePosition(position.play(move), depth - 1);
+		if (grade.bestMove < 0 || score > grade.bestScore){
+			grade.bestMove = move;
+			grade.bestScore = score;
+		}
+		if (move == grade.move){
+			grade.playedScore = score;
+		}
+	}
+	grade.exact = false;
+}
+
+/**
+ * Replays a game on a ReversiBoard and grades all its moves in
+ * parallel, every move is one task of the pool
+ * \param const std::vector<int>& moves	: [IN] moves of the game,
+ * 										without passes
+ * \param std::vector<MoveGrade>& grades	: [OUT] grade of every move
+ * \return false if a move is not valid
+ */
+bool ReversiGameAnalysis::analyze(const vector<int>& moves,
+		vector<MoveGrade>& grades)
+{
+	ReversiBoard board;
+	bool player1 = true;
+	grades.clear();
+	for (size_t index = 0; index < moves.size(); index++){
+		if (!board.hasValidMove(player1)){
+			player1 = !player1;
+		}
+		MoveGrade grade{board.getPosition(player1), moves[index], -1, 0, 0,
+			false};
+		if (moves[index] < 0 ||
+				!board.setField(moves[index] / 8 + 1, moves[index] % 8 + 1,
+				player1)){
+			cout << "Invalid move " << index + 1 << ": " <<
+					ReversiPosition::moveToString(moves[index]) << endl;
+			return false;
+		}
+		grades.push_back(grade);
+		player1 = !player1;
+	}
+
+	mutex doneMutex;
+	condition_variable allDone;
+	size_t pending = grades.size();
+	for (size_t index = 0; index < grades.size(); index++){
+		pool.submit([&, index]{
+			gradeMove(grades[index]);
+			lock_guard<mutex> lock(doneMutex);
+			if (--pending == 0){
+				allDone.notify_all();
+			}
+		});
+	}
+	unique_lock<mutex> lock(doneMutex);
+	allDone.wait(lock, [&]{ return pending == 0; });
+	return true;
+}
+
+/**
+ * Grades the games of a game file, or a single game given as moves, and
+ * prints every game annotated with the grades and its wall time. Each
+ * move is printed with the score of the move played, the best move and
+ * its score if it is another one, the loss and a mark for inaccuracies,
+ * mistakes and blunders. Scores are from the view of the player who
+ * moved, exact scores are marked with =
+ * \param const std::string& games	: [IN] game file or moves
+ * \param int depth			: [IN] depth of the searches in moves
+ * \param int exactEmpties	: [IN] most empty fields of a position that is
+ * 							solved exactly
+ * \param int threadCount	: [IN] number of threads
+ * \return false if the file cannot be read or a game is invalid
+ */
+bool ReversiGameAnalysis::run(const string& games, int depth,
+		int exactEmpties, int threadCount)
+{
+	vector<string> lines;
+	ifstream file(games.c_str());
+	if (file){
+		string line;
+		while (getline(file, line)){
+			if (ReversiGameFile::isGame(line)){
+				lines.push_back(line);
+			}
+		}
+	}
+	else{
+		lines.push_back(games);
+	}
+
+	ReversiGameAnalysis analysis(threadCount, depth, exactEmpties);
+	for (size_t game = 0; game < lines.size(); game++){
+		vector<int> moves;
+		if (!ReversiGameFile::parse(lines[game], moves)){
+			cout << "Invalid game " << game + 1 << ": " << lines[game] << endl;
+			return false;
+		}
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		vector<MoveGrade> grades;
+		if (!analysis.analyze(moves, grades)){
+			return false;
+		}
+		double seconds = chrono::duration<double>(
+				chrono::steady_clock::now() - start).count();
+
+		cout << "# game " << game + 1 << ": " <<
+				ReversiGameFile::format(moves) << endl;
+		int totalLoss[2] = {0, 0};
+		int marked[2][3] = {{0, 0, 0}, {0, 0, 0}};
+		for (size_t index = 0; index < grades.size(); index++){
+			const MoveGrade& grade = grades[index];
+			int side = grade.position.isPlayer1ToMove() ? 0 : 1;
+			int loss = grade.bestScore - grade.playedScore;
+			totalLoss[side] += loss;
+			cout << setw(2) << index + 1 << ". " << (side == 0 ? 'X' : 'O') <<
+					' ' << ReversiPosition::moveToString(grade.move) << ' ' <<
+					(grade.exact ? "=" : "") <<
+					formatScore(grade.playedScore);
+			if (loss > 0){
+				cout << "  best " <<
+						ReversiPosition::moveToString(grade.bestMove) << ' ' <<
+						(grade.exact ? "=" : "") <<
+						formatScore(grade.bestScore) << "  loss " <<
+						formatScore(loss).substr(1);
+				int mark = loss >= blunderLoss ? 2 : loss >= mistakeLoss ? 1 :
+						loss >= inaccuracyLoss ? 0 : -1;
+				if (mark >= 0){
+					cout << (mark == 2 ? " ??" : mark == 1 ? " ?" : " ?!");
+					marked[side][mark]++;
+				}
+			}
+			cout << endl;
+		}
+		for (int side = 0; side < 2; side++){
+			int moveCount = 0;
+			for (size_t index = 0; index < grades.size(); index++){
+				moveCount += grades[index].position.isPlayer1ToMove() ==
+						(side == 0);
+			}
+			cout << (side == 0 ? "PLAYER1 (X)" : "PLAYER2 (O)") <<
+					": total loss " << formatScore(totalLoss[side]).substr(1) <<
+					", mean loss " << formatScore(moveCount > 0 ?
+					totalLoss[side] / moveCount : 0).substr(1) << ", " <<
+					marked[side][0] << " inaccuracies, " << marked[side][1] <<
+					" mistakes, " << marked[side][2] << " blunders" << endl;
+		}
+		cout << fixed << setprecision(2) << "Analyzed " << grades.size() <<
+				" moves at depth " << depth << ", exact from " <<
+				exactEmpties << " empties, with " << threadCount <<
+				" threads in " << seconds << " s" << endl;
+	}
+	return true;
+}
+
+/**
+ * Destructor of class ReversiGameAnalysis
+ */
+ReversiGameAnalysis::~ReversiGameAnalysis()
+{
+}
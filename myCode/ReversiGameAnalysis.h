@@ -0,0 +1,119 @@
+/*
+ * ReversiGameAnalysis.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIGAMEANALYSIS_H_
+#define REVERSIGAMEANALYSIS_H_
+
+#include <string>
+#include <vector>
+#include "ReversiHashTable.h"
+#include "ReversiPosition.h"
+#include "ReversiSolver.h"
+#include "ReversiThreadPool.h"
+
+/**
+ * Grades every move of a finished game. The game is replayed on a
+ * ReversiBoard, then the positions before all moves are analyzed at the
+ * same time by the tasks of a pool: each task finds the best move and
+ * its score and scores the move that was played. Positions with few
+ * empty fields are solved exactly, the others searched to a fixed depth.
+ * All searches share one hash table and all exact solves the hash table
+ * of one solver. The result is printed as an annotated game with the
+ * loss of every move, the losses per player and the wall time
+ */
+class ReversiGameAnalysis
+{
+public:
+	/**
+	 * Grade of one move. Scores are in 1/100 discs from the view of the
+	 * player who moved
+	 */
+	struct MoveGrade{
+		ReversiPosition position;	// position before the move
+		int move;			// move played
+		int bestMove;		// best move found
+		int bestScore;		// score of the best move
+		int playedScore;	// score of the move played
+		bool exact;			// true if the scores are exact
+	};
+
+private:
+	/**
+	 * Pool analyzing the positions and splitting the exact solves
+	 */
+	ReversiThreadPool pool;
+
+	/**
+	 * Hash table shared by the searches of all positions
+	 */
+	ReversiHashTable hashTable;
+
+	/**
+	 * Solver of the positions with few empty fields
+	 */
+	ReversiSolver solver;
+
+	/**
+	 * Depth of the searches in moves
+	 */
+	int depth;
+
+	/**
+	 * Most empty fields of a position that is solved exactly
+	 */
+	int exactEmpties;
+
+	/**
+	 * Grades one move
+	 * \param MoveGrade& grade	: [IN,OUT] position and move played in,
+	 * 							scores and best move out
+	 */
+	void gradeMove(MoveGrade& grade);
+
+public:
+	/**
+	 * Constructor of class ReversiGameAnalysis
+	 * \param int threadCount	: [IN] number of threads
+	 * \param int depth			: [IN] depth of the searches in moves
+	 * \param int exactEmpties	: [IN] most empty fields of a position that
+	 * 							is solved exactly
+	 * \param int hashSizeMb	: [IN] size of each hash table in megabytes
+	 */
+	ReversiGameAnalysis(int threadCount, int depth, int exactEmpties,
+			int hashSizeMb = 64);
+
+	/**
+	 * Replays a game on a ReversiBoard and grades all its moves in
+	 * parallel
+	 * \param const std::vector<int>& moves	: [IN] moves of the game,
+	 * 										without passes
+	 * \param std::vector<MoveGrade>& grades	: [OUT] grade of every move
+	 * \return false if a move is not valid
+	 */
+	bool analyze(const std::vector<int>& moves,
+			std::vector<MoveGrade>& grades);
+
+	/**
+	 * Grades the games of a game file, or a single game given as moves,
+	 * and prints every game annotated with the grades and its wall time
+	 * \param const std::string& games	: [IN] game file or moves
+	 * \param int depth			: [IN] depth of the searches in moves
+	 * \param int exactEmpties	: [IN] most empty fields of a position that
+	 * 							is solved exactly
+	 * \param int threadCount	: [IN] number of threads
+	 * \return false if the file cannot be read or a game is invalid
+	 */
+	static bool run(const std::string& games, int depth, int exactEmpties,
+			int threadCount);
+
+	/**
+	 * Destructor of class ReversiGameAnalysis
+	 */
+	virtual ~ReversiGameAnalysis();
+};
+
+#endif /* REVERSIGAMEANALYSIS_H_ */
@@ -0,0 +1,96 @@
+/*
+ * ReversiGameFile.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include "ReversiGameFile.h"
+using namespace std;
+
+/**
+ * Reads the moves of a game line
+ * \param const std::string& line	: [IN] text of the game
+ * \param std::vector<int>& moves	: [OUT] array indices of the moves,
+ * 									without passes
+ * \return false if the line has an invalid move name
+ */
+bool ReversiGameFile::parse(const string& line, vector<int>& moves)
+{
+	moves.clear();
+	size_t index = 0;
+	while (index < line.size()){
+		if (line[index] == ' ' || line[index] == '\t' || line[index] == '\r'){
+			index++;
+			continue;
+		}
+		int move = ReversiPosition::moveFromString(line.substr(index, 2));
+		if (move == -2){
+			return false;
+		}
+		if (move >= 0){
+			moves.push_back(move);
+		}
+		index += 2;
+	}
+	return true;
+}
+
+/**
+ * Writes the moves of a game as a game line
+ * \param const std::vector<int>& moves	: [IN] array indices of the
+ * 										moves, passes (-1) are skipped
+ * \return text of the game
+ */
+string ReversiGameFile::format(const vector<int>& moves)
+{
+	string line;
+	for (size_t index = 0; index < moves.size(); index++){
+		if (moves[index] >= 0){
+			line += ReversiPosition::moveToString(moves[index]);
+		}
+	}
+	return line;
+}
+
+/**
+ * Plays the moves of a game from the start position. Passes are
+ * inserted where a side has no valid move
+ * \param const std::vector<int>& moves	: [IN] array indices of the moves
+ * \param std::vector<ReversiPosition>& positions	: [OUT] position
+ * 						before every move and after the last move,
+ * 						positions after a pass are not included
+ * \return false if a move is not valid, positions holds the positions
+ * 			up to it then
+ */
+bool ReversiGameFile::replay(const vector<int>& moves,
+		vector<ReversiPosition>& positions)
+{
+	positions.clear();
+	ReversiPosition position = ReversiPosition::initial();
+	for (size_t index = 0; index < moves.size(); index++){
+		if (position.validMoves() == 0){
+			position = position.pass();
+		}
+		positions.push_back(position);
+		if (!((position.validMoves() >> moves[index]) & 1)){
+			return false;
+		}
+		position = position.play(moves[index]);
+	}
+	if (position.validMoves() == 0 && position.pass().validMoves() != 0){
+		position = position.pass();
+	}
+	positions.push_back(position);
+	return true;
+}
+
+/**
+ * Checks if a line holds a game
+ * \param const std::string& line	: [IN] line of a game file
+ * \return false for empty lines and comments
+ */
+bool ReversiGameFile::isGame(const string& line)
+{
+	return line.find_first_not_of(" \t\r") != string::npos && line[0] != '#';
+}
@@ -0,0 +1,63 @@
+/*
+ * ReversiGameFile.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIGAMEFILE_H_
+#define REVERSIGAMEFILE_H_
+
+#include <string>
+#include <vector>
+#include "ReversiPosition.h"
+
+/**
+ * Text format of games: one game per line, the moves in the notation of
+ * ReversiPosition::moveToString one after the other, for example
+ * f4f3e3c5. Blanks between moves are allowed. Passes may be written as
+ * -- but do not have to be, a side without a valid move passes
+ * automatically. Empty lines and lines starting with # are no games
+ */
+class ReversiGameFile
+{
+public:
+	/**
+	 * Reads the moves of a game line
+	 * \param const std::string& line	: [IN] text of the game
+	 * \param std::vector<int>& moves	: [OUT] array indices of the moves,
+	 * 									without passes
+	 * \return false if the line has an invalid move name
+	 */
+	static bool parse(const std::string& line, std::vector<int>& moves);
+
+	/**
+	 * Writes the moves of a game as a game line
+	 * \param const std::vector<int>& moves	: [IN] array indices of the
+	 * 										moves, passes (-1) are skipped
+	 * \return text of the game
+	 */
+	static std::string format(const std::vector<int>& moves);
+
+	/**
+	 * Plays the moves of a game from the start position. Passes are
+	 * inserted where a side has no valid move
+	 * \param const std::vector<int>& moves	: [IN] array indices of the moves
+	 * \param std::vector<ReversiPosition>& positions	: [OUT] position
+	 * 						before every move and after the last move,
+	 * 						positions after a pass are not included
+	 * \return false if a move is not valid, positions holds the positions
+	 * 			up to it then
+	 */
+	static bool replay(const std::vector<int>& moves,
+			std::vector<ReversiPosition>& positions);
+
+	/**
+	 * Checks if a line holds a game
+	 * \param const std::string& line	: [IN] line of a game file
+	 * \return false for empty lines and comments
+	 */
+	static bool isGame(const std::string& line);
+};
+
+#endif /* REVERSIGAMEFILE_H_ */
@@ -0,0 +1,110 @@
+/*
+ * ReversiHashTable.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include "ReversiHashTable.h"
+
+/**
+ * Constructor that allocates a table of the given size
+ * The number of entries is rounded down to a power of two so that a key
+ * can be mapped to a slot with a mask instead of a division
+ * \param int sizeMb	: [IN] size of the table in megabytes
+ */
+ReversiHashTable::ReversiHashTable(int sizeMb): mask(0), generation(0)
+{
+	uint64_t entries = 1;
+	uint64_t wanted = (uint64_t)(sizeMb > 0 ? sizeMb : 1) * 1024 * 1024 /
+			sizeof(Entry);
+	while (entries * 2 <= wanted){
+		entries *= 2;
+	}
+	pEntries.reset(new Entry[entries]);
+	mask = entries - 1;
+	clear();
+}
+
+/**
+ * Looks up a position in the table
+ * \param uint64_t key	: [IN] key of the position
+ * \param int& depth	: [OUT] depth of the stored search
+ * \param int& score	: [OUT] stored score
+ * \param BOUND_t& bound: [OUT] bound type of the stored score
+ * \param int& move		: [OUT] stored best move or noMove
+ * \return true if the position was found, else false
+ */
+bool ReversiHashTable::probe(uint64_t key, int& depth, int& score,
+		BOUND_t& bound, int& move) const
+{
+	const Entry& entry = pEntries[key & mask];
+	uint64_t data = entry.data.load(std::memory_order_relaxed);
+	uint64_t check = entry.check.load(std::memory_order_relaxed);
+	if ((check ^ data) != key || data == 0){
+		return false;
+	}
+	score = (int)(data & 0xFFFF) - 32768;
+	depth = (int)((data >> 16) & 0xFF);
+	bound = (BOUND_t)((data >> 24) & 0x3);
+	move = (int)((data >> 32) & 0xFF);
+	return true;
+}
+
+/**
+ * Stores the result of a search in the table. An entry of the same
+ * position searched deeper in the current generation is kept
+ * \param uint64_t key	: [IN] key of the position
+ * \param int depth		: [IN] depth of the search
+ * \param int score		: [IN] score of the search
+ * \param BOUND_t bound	: [IN] bound type of the score
+ * \param int move		: [IN] best move found or noMove
+ */
+void ReversiHashTable::store(uint64_t key, int depth, int score,
+		BOUND_t bound, int move)
+{
+	Entry& entry = pEntries[key & mask];
+	uint64_t oldData = entry.data.load(std::memory_order_relaxed);
+	uint64_t oldCheck = entry.check.load(std::memory_order_relaxed);
+	if ((oldCheck ^ oldData) == key &&
+			((oldData >> 40) & 0xFF) == generation &&
+			(int)((oldData >> 16) & 0xFF) > depth){
+		return;
+	}
+	if (move == noMove && (oldCheck ^ oldData) == key){
+		move = (int)((oldData >> 32) & 0xFF);	// keep the known best move
+	}
+	uint64_t data = (uint64_t)(score + 32768) |
+			((uint64_t)(depth & 0xFF) << 16) |
+			((uint64_t)bound << 24) |
+			((uint64_t)(move & 0xFF) << 32) |
+			((uint64_t)generation << 40);
+	entry.data.store(data, std::memory_order_relaxed);
+	entry.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+/**
+ * Starts a new generation, called once before every new search
+ */
+void ReversiHashTable::newSearch()
+{
+	generation++;
+}
+
+/**
+ * Removes all entries from the table
+ */
+void ReversiHashTable::clear()
+{
+	for (uint64_t index = 0; index <= mask; index++){
+		pEntries[index].check.store(0, std::memory_order_relaxed);
+		pEntries[index].data.store(0, std::memory_order_relaxed);
+	}
+}
+
+/**
+ * Destructor of class ReversiHashTable, frees the entries
+ */
+ReversiHashTable::~ReversiHashTable()
+{
+}
@@ -0,0 +1,108 @@
+/*
+ * ReversiHashTable.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIHASHTABLE_H_
+#define REVERSIHASHTABLE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+class ReversiHashTable
+{
+public:
+	/*
+	 * Enum to represent how the stored score relates to the true score
+	 * of the position: exact, lower bound (fail high) or upper bound
+	 * (fail low)
+	 */
+	enum BOUND_t{
+		BOUND_NONE,
+		BOUND_LOWER,
+		BOUND_UPPER,
+		BOUND_EXACT,
+	};
+
+	/**
+	 * Value of the stored best move when no move is known
+	 */
+	static const int noMove = 255;
+
+private:
+	/**
+	 * One slot of the table. The check word holds key XOR data, so a slot
+	 * torn by two threads writing at the same time simply fails the check
+	 * on the next probe instead of returning a mixed up entry
+	 */
+	struct Entry{
+		std::atomic<uint64_t> check;
+		std::atomic<uint64_t> data;
+	};
+
+	/**
+	 * Array of entries, the number of entries is always a power of two
+	 */
+	std::unique_ptr<Entry[]> pEntries;
+
+	/**
+	 * Number of entries minus one, used to map a key to a slot
+	 */
+	uint64_t mask;
+
+	/**
+	 * Generation counter, increased for every new search so that entries
+	 * of old searches are replaced first
+	 */
+	uint8_t generation;
+
+public:
+	/**
+	 * Constructor that allocates a table of the given size
+	 * \param int sizeMb	: [IN] size of the table in megabytes
+	 */
+	ReversiHashTable(int sizeMb);
+
+	/**
+	 * Looks up a position in the table
+	 * \param uint64_t key	: [IN] key of the position
+	 * \param int& depth	: [OUT] depth of the stored search
+	 * \param int& score	: [OUT] stored score
+	 * \param BOUND_t& bound: [OUT] bound type of the stored score
+	 * \param int& move		: [OUT] stored best move or noMove
+	 * \return true if the position was found, else false
+	 */
+	bool probe(uint64_t key, int& depth, int& score, BOUND_t& bound,
+			int& move) const;
+
+	/**
+	 * Stores the result of a search in the table. An entry of the same
+	 * position searched deeper in the current generation is kept
+	 * \param uint64_t key	: [IN] key of the position
+	 * \param int depth		: [IN] depth of the search
+	 * \param int score		: [IN] score of the search
+	 * \param BOUND_t bound	: [IN] bound type of the score
+	 * \param int move		: [IN] best move found or noMove
+	 */
+	void store(uint64_t key, int depth, int score, BOUND_t bound, int move);
+
+	/**
+	 * Starts a new generation, called once before every new search
+	 */
+	void newSearch();
+
+	/**
+	 * Removes all entries from the table
+	 */
+	void clear();
+
+	/**
+	 * Destructor of class ReversiHashTable, frees the entries
+	 */
+	virtual ~ReversiHashTable();
+};
+
+#endif /* REVERSIHASHTABLE_H_ */
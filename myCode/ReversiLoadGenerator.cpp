@@ -0,0 +1,220 @@
+/*
+ * ReversiLoadGenerator.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include "ReversiLoadGenerator.h"
+using namespace std;
+
+#ifdef __linux__
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Constructor of class ReversiLoadGenerator
+ * \param const std::string& path	: [IN] path of the server's socket
+ * \param int connections			: [IN] number of connections
+ * \param int gamesPerConnection	: [IN] games played per connection
+ * \param int requestsPerConnection	: [IN] commands sent per connection
+ * \param int playDepth				: [IN] depth of the computer moves
+ */
+ReversiLoadGenerator::ReversiLoadGenerator(const string& path,
+		int connections, int gamesPerConnection, int requestsPerConnection,
+		int playDepth): socketPath(path), connections(connections),
+		gamesPerConnection(gamesPerConnection),
+		requestsPerConnection(requestsPerConnection), playDepth(playDepth)
+{
+}
+
+#ifdef __linux__
+
+/**
+ * Sends the commands of one connection and records their latencies
+ * The games are served round robin. For every game the valid moves are
+ * requested first, then a random one is played or the computer is asked
+ * to move. A finished game is ended and replaced by a new one
+ * \param int seed						: [IN] seed of the random moves
+ * \param std::vector<double>& latencies: [OUT] latencies in microseconds
+ * \param int& errors					: [OUT] number of failed commands
+ */
+void ReversiLoadGenerator::runConnection(int seed, vector<double>& latencies,
+		int& errors)
+{
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, socketPath.c_str(),
+			sizeof(address.sun_path) - 1);
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) < 0){
+		errors = requestsPerConnection;
+		if (fd >= 0){
+			close(fd);
+		}
+		return;
+	}
+
+	string input;
+	bool connected = true;
+	// Sends a command and waits for its answer line
+	auto request = [&](const string& command) -> string {
+		string line = command + "\n";
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		if (!connected || send(fd, line.data(), line.size(), MSG_NOSIGNAL) !=
+				(ssize_t)line.size()){
+			connected = false;
+			errors++;
+			return "ERR";
+		}
+		size_t end;
+		char buffer[4096];
+		while ((end = input.find('\n')) == string::npos){
+			ssize_t length = read(fd, buffer, sizeof(buffer));
+			if (length <= 0){
+				connected = false;
+				errors++;
+				return "ERR";
+			}
+			input.append(buffer, length);
+		}
+		string answer = input.substr(0, end);
+		input.erase(0, end + 1);
+		latencies.push_back(chrono::duration<double, micro>(
+				chrono::steady_clock::now() - start).count());
+		if (answer.compare(0, 2, "OK") != 0){
+			errors++;
+		}
+		return answer;
+	};
+
+	mt19937 random(seed);
+	// Starts a game and returns its number, or an empty string if the
+	// server has refused it, so the slot is not used any more
+	auto startGame = [&]() -> string {
+		string answer = request("NEW");
+		return answer.compare(0, 3, "OK ") == 0 ? answer.substr(3) : "";
+	};
+	vector<string> gameIds(gamesPerConnection);
+	vector<vector<string> > moves(gamesPerConnection);
+	vector<int> steps(gamesPerConnection, 0);
+	int sent = 0;
+	int activeGames = 0;
+	for (int game = 0; game < gamesPerConnection; game++, sent++){
+		gameIds[game] = startGame();
+		activeGames += !gameIds[game].empty();
+	}
+	for (int game = 0; sent < requestsPerConnection && connected &&
+			activeGames > 0; game = (game + 1) % gamesPerConnection){
+		if (gameIds[game].empty()){
+			continue;
+		}
+		int step = steps[game]++;
+		sent++;
+		if (step % 2 == 0){
+			istringstream answer(request("MOVES " + gameIds[game]).substr(2));
+			string row;
+			string column;
+			moves[game].clear();
+			while (answer >> row >> column){
+				moves[game].push_back(row + " " + column);
+			}
+		}
+		else if (moves[game].empty()){
+			request("END " + gameIds[game]);
+			gameIds[game] = startGame();
+			activeGames -= gameIds[game].empty();
+			sent++;
+		}
+		else if (step % 8 == 7){
+			request("PLAY " + gameIds[game] + " " + to_string(playDepth));
+		}
+		else{
+			request("MOVE " + gameIds[game] + " " +
+					moves[game][random() % moves[game].size()]);
+		}
+	}
+	for (int game = 0; game < gamesPerConnection && connected; game++){
+		if (!gameIds[game].empty()){
+			request("END " + gameIds[game]);
+		}
+	}
+	close(fd);
+}
+
+#else
+
+/**
+ * Unix domain sockets are only used on Linux
+ * \param int seed						: [IN] seed of the random moves
+ * \param std::vector<double>& latencies: [OUT] latencies in microseconds
+ * \param int& errors					: [OUT] number of failed commands
+ */
+void ReversiLoadGenerator::runConnection(int seed, vector<double>& latencies,
+		int& errors)
+{
+	errors = requestsPerConnection;
+}
+
+#endif
+
+/**
+ * Runs all connections and prints requests per second and the
+ * latency percentiles
+ * \return false if no command could be sent, else true
+ */
+bool ReversiLoadGenerator::run()
+{
+	vector<vector<double> > latencies(connections);
+	vector<int> errors(connections, 0);
+	vector<thread> threads;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int connection = 0; connection < connections; connection++){
+		threads.push_back(thread(&ReversiLoadGenerator::runConnection, this,
+				connection + 1, ref(latencies[connection]),
+				ref(errors[connection])));
+	}
+	for (size_t index = 0; index < threads.size(); index++){
+		threads[index].join();
+	}
+	double seconds = chrono::duration<double>(
+			chrono::steady_clock::now() - start).count();
+
+	vector<double> all;
+	int errorCount = 0;
+	for (int connection = 0; connection < connections; connection++){
+		all.insert(all.end(), latencies[connection].begin(),
+				latencies[connection].end());
+		errorCount += errors[connection];
+	}
+	if (all.empty()){
+		cerr << "No command could be sent to " << socketPath << endl;
+		return false;
+	}
+	sort(all.begin(), all.end());
+	cout << "Requests: " << all.size() << " (" << errorCount << " failed)"
+			<< endl;
+	cout << "Concurrent games: " << connections * gamesPerConnection << endl;
+	cout << "Requests/second: " << (long)(all.size() / seconds) << endl;
+	cout << "Latency p50: " << all[all.size() / 2] << " us" << endl;
+	cout << "Latency p99: " << all[all.size() * 99 / 100] << " us" << endl;
+	cout << "Latency max: " << all.back() << " us" << endl;
+	return true;
+}
+
+/**
+ * Destructor of class ReversiLoadGenerator
+ */
+ReversiLoadGenerator::~ReversiLoadGenerator()
+{
+}
@@ -0,0 +1,83 @@
+/*
+ * ReversiLoadGenerator.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSILOADGENERATOR_H_
+#define REVERSILOADGENERATOR_H_
+
+#include <string>
+#include <vector>
+
+/**
+ * Load generator for the ReversiServer. Every connection is served by
+ * its own thread which plays several games at once with random moves and
+ * lets the computer answer every fourth move. Each thread waits for the
+ * answer before it sends the next command, the time in between is the
+ * latency of the command
+ */
+class ReversiLoadGenerator
+{
+	/**
+	 * Path of the server's socket
+	 */
+	std::string socketPath;
+
+	/**
+	 * Number of connections
+	 */
+	int connections;
+
+	/**
+	 * Number of games played at once per connection
+	 */
+	int gamesPerConnection;
+
+	/**
+	 * Number of commands sent per connection
+	 */
+	int requestsPerConnection;
+
+	/**
+	 * Depth of the computer moves
+	 */
+	int playDepth;
+
+	/**
+	 * Sends the commands of one connection and records their latencies
+	 * \param int seed						: [IN] seed of the random moves
+	 * \param std::vector<double>& latencies: [OUT] latencies in microseconds
+	 * \param int& errors					: [OUT] number of failed commands
+	 */
+	void runConnection(int seed, std::vector<double>& latencies,
+			int& errors);
+
+public:
+	/**
+	 * Constructor of class ReversiLoadGenerator
+	 * \param const std::string& path	: [IN] path of the server's socket
+	 * \param int connections			: [IN] number of connections
+	 * \param int gamesPerConnection	: [IN] games played per connection
+	 * \param int requestsPerConnection	: [IN] commands sent per connection
+	 * \param int playDepth				: [IN] depth of the computer moves
+	 */
+	ReversiLoadGenerator(const std::string& path, int connections,
+			int gamesPerConnection, int requestsPerConnection,
+			int playDepth);
+
+	/**
+	 * Runs all connections and prints requests per second and the
+	 * latency percentiles
+	 * \return false if no command could be sent, else true
+	 */
+	bool run();
+
+	/**
+	 * Destructor of class ReversiLoadGenerator
+	 */
+	virtual ~ReversiLoadGenerator();
+};
+
+#endif /* REVERSILOADGENERATOR_H_ */
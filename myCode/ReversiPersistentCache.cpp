@@ -0,0 +1,352 @@
+/*
+ * ReversiPersistentCache.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "ReversiEngine.h"
+#include "ReversiPersistentCache.h"
+#include "ReversiPositionFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define REVERSIPERSISTENTCACHE_MMAP
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * Magic bytes and version of the file format
+ */
+static const char cacheMagic[8] = {'R', 'V', 'C', 'A', 'C', 'H', 'E', '1'};
+static const uint32_t cacheVersion = 1;
+
+/**
+ * Constructor of class ReversiPersistentCache, no file is open
+ */
+ReversiPersistentCache::ReversiPersistentCache(): mapping(nullptr),
+		mappingSize(0), pEntries(nullptr), bucketMask(0), probes(0), hits(0)
+{
+}
+
+#ifdef REVERSIPERSISTENTCACHE_MMAP
+
+/**
+ * Creates a new cache file, if no file of that name exists yet. The
+ * file is written under a name of its own and then linked to the final
+ * name, which fails if another process was faster; its file is used then
+ * \param const std::string& path	: [IN] path of the file
+ * \param int sizeMb				: [IN] size of the entries in megabytes
+ * \return false if the file could not be created
+ */
+bool ReversiPersistentCache::create(const string& path, int sizeMb)
+{
+	uint64_t bucketCount = 1;
+	uint64_t wanted = (uint64_t)(sizeMb > 0 ? sizeMb : 1) * 1024 * 1024 /
+			(bucketEntries * sizeof(Entry));
+	while (bucketCount * 2 <= wanted){
+		bucketCount *= 2;
+	}
+	Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, cacheMagic, sizeof(header.magic));
+	header.version = cacheVersion;
+	header.entrySize = sizeof(Entry);
+	header.bucketCount = bucketCount;
+
+	string tempPath = path + ".tmp" + to_string(getpid());
+	int fd = ::open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0){
+		return false;
+	}
+	// The entries are zero, which is an empty entry, as the file is
+	// extended with holes
+	bool written = ftruncate(fd, sizeof(Header) +
+			bucketCount * bucketEntries * sizeof(Entry)) == 0 &&
+			pwrite(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header)
+			&& fsync(fd) == 0;
+	::close(fd);
+	bool linked = written && (link(tempPath.c_str(), path.c_str()) == 0 ||
+			errno == EEXIST);
+	unlink(tempPath.c_str());
+	return linked;
+}
+
+/**
+ * Opens a cache file, creating it if it does not exist. The header is
+ * checked against the size of the file before any entry is used
+ * \param const std::string& path	: [IN] path of the file
+ * \param int sizeMb	: [IN] size of a new file in megabytes, an
+ * 						existing file keeps its size
+ * \return false if the file could not be opened or is no cache file
+ */
+bool ReversiPersistentCache::open(const string& path, int sizeMb)
+{
+	close();
+	if (!atomic<uint64_t>().is_lock_free()){
+		cout << "The cache needs lock-free 64 bit atomics" << endl;
+		return false;
+	}
+	int fd = ::open(path.c_str(), O_RDWR);
+	if (fd < 0 && errno == ENOENT){
+		if (!create(path, sizeMb)){
+			cout << "Cannot create " << path << endl;
+			return false;
+		}
+		fd = ::open(path.c_str(), O_RDWR);
+	}
+	struct stat status;
+	if (fd < 0 || fstat(fd, &status) != 0){
+		cout << "Cannot open " << path << endl;
+		if (fd >= 0){
+			::close(fd);
+		}
+		return false;
+	}
+	mappingSize = (size_t)status.st_size;
+	void* address = mappingSize >= sizeof(Header) ? mmap(nullptr,
+			mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) :
+			MAP_FAILED;
+	::close(fd);
+	if (address == MAP_FAILED){
+		cout << "Cannot map " << path << endl;
+		return false;
+	}
+	mapping = address;
+
+	const Header* pHeader = (const Header*)mapping;
+	uint64_t bucketCount = pHeader->bucketCount;
+	if (memcmp(pHeader->magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+			pHeader->version != cacheVersion ||
+			pHeader->entrySize != sizeof(Entry) || bucketCount == 0 ||
+			(bucketCount & (bucketCount - 1)) != 0 ||
+			mappingSize != sizeof(Header) +
+					bucketCount * bucketEntries * sizeof(Entry)){
+		cout << path << " is no valid cache file" << endl;
+		close();
+		return false;
+	}
+	pEntries = (Entry*)((char*)mapping + sizeof(Header));
+	bucketMask = bucketCount - 1;
+	probes.store(0);
+	hits.store(0);
+	return true;
+}
+
+/**
+ * Closes the file. The entries written stay in the file, the system
+ * writes the changed pages back even if the process crashes later
+ */
+void ReversiPersistentCache::close()
+{
+	if (mapping){
+		munmap(mapping, mappingSize);
+	}
+	mapping = nullptr;
+	mappingSize = 0;
+	pEntries = nullptr;
+	bucketMask = 0;
+}
+
+#else
+
+/**
+ * Creates a new cache file, not available without mmap
+ * \param const std::string& path	: [IN] path of the file
+ * \param int sizeMb				: [IN] size of the entries in megabytes
+ * \return false
+ */
+bool ReversiPersistentCache::create(const string& path, int sizeMb)
+{
+	return false;
+}
+
+/**
+ * Opens a cache file, not available without mmap
+ * \param const std::string& path	: [IN] path of the file
+ * \param int sizeMb	: [IN] size of a new file in megabytes
+ * \return false
+ */
+bool ReversiPersistentCache::open(const string& path, int sizeMb)
+{
+	cout << "The persistent cache is only available on POSIX systems" <<
+			endl;
+	return false;
+}
+
+/**
+ * Closes the file
+ */
+void ReversiPersistentCache::close()
+{
+}
+
+#endif
+
+/**
+ * Looks up a position by its canonical form and maps the stored move
+ * back to the position
+ * \param const ReversiPosition& position	: [IN] position to look up
+ * \param int& depth	: [OUT] depth of the stored search
+ * \param int& score	: [OUT] stored score
+ * \param ReversiHashTable::BOUND_t& bound	: [OUT] bound type of the
+ * 						stored score
+ * \param int& move		: [OUT] stored best move of the position or
+ * 						ReversiHashTable::noMove
+ * \return true if the position was found, else false
+ */
+bool ReversiPersistentCache::probe(const ReversiPosition& position,
+		int& depth, int& score, ReversiHashTable::BOUND_t& bound, int& move)
+{
+	if (!pEntries){
+		return false;
+	}
+	probes.fetch_add(1, memory_order_relaxed);
+	int symmetry;
+	uint64_t key = position.canonical(symmetry).hash();
+	const Entry* pBucket = pEntries + (key & bucketMask) * bucketEntries;
+	for (int slot = 0; slot < bucketEntries; slot++){
+		uint64_t data = pBucket[slot].data.load(memory_order_relaxed);
+		uint64_t check = pBucket[slot].check.load(memory_order_relaxed);
+		if ((check ^ data) != key || data == 0){
+			continue;
+		}
+		score = (int)(data & 0xFFFF) - 32768;
+		depth = (int)((data >> 16) & 0xFF);
+		bound = (ReversiHashTable::BOUND_t)((data >> 24) & 0x3);
+		move = (int)((data >> 32) & 0xFF);
+		if (move != ReversiHashTable::noMove){
+			move = ReversiPosition::untransformMove(move, symmetry);
+		}
+		hits.fetch_add(1, memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Stores the result of a search. An entry of the same position searched
+ * deeper is kept, else the entry of the position or, if there is none,
+ * the entry with the shallowest search in the bucket is replaced
+ * \param const ReversiPosition& position	: [IN] searched position
+ * \param int depth		: [IN] depth of the search
+ * \param int score		: [IN] score of the search
+ * \param ReversiHashTable::BOUND_t bound	: [IN] bound type of the score
+ * \param int move		: [IN] best move found or ReversiHashTable::noMove
+ */
+void ReversiPersistentCache::store(const ReversiPosition& position,
+		int depth, int score, ReversiHashTable::BOUND_t bound, int move)
+{
+	if (!pEntries){
+		return;
+	}
+	int symmetry;
+	uint64_t key = position.canonical(symmetry).hash();
+	if (move != ReversiHashTable::noMove){
+		move = ReversiPosition::transformMove(move, symmetry);
+	}
+	Entry* pBucket = pEntries + (key & bucketMask) * bucketEntries;
+	int target = 0;
+	int targetDepth = 256;
+	for (int slot = 0; slot < bucketEntries; slot++){
+		uint64_t oldData = pBucket[slot].data.load(memory_order_relaxed);
+		uint64_t oldCheck = pBucket[slot].check.load(memory_order_relaxed);
+		int oldDepth = oldData == 0 ? -1 : (int)((oldData >> 16) & 0xFF);
+		if ((oldCheck ^ oldData) == key && oldData != 0){
+			if (oldDepth > depth){
+				return;
+			}
+			if (move == ReversiHashTable::noMove){
+				move = (int)((oldData >> 32) & 0xFF);	// keep the best move
+			}
+			target = slot;
+			break;
+		}
+		if (oldDepth < targetDepth){
+			target = slot;
+			targetDepth = oldDepth;
+		}
+	}
+	uint64_t data = (uint64_t)(score + 32768) |
+			((uint64_t)(depth & 0xFF) << 16) |
+			((uint64_t)bound << 24) |
+			((uint64_t)(move & 0xFF) << 32);
+	pBucket[target].data.store(data, memory_order_relaxed);
+	pBucket[target].check.store(key ^ data, memory_order_relaxed);
+}
+
+/**
+ * Returns the number of lookups since the file was opened
+ * \return number of lookups
+ */
+uint64_t ReversiPersistentCache::getProbes() const
+{
+	return probes.load();
+}
+
+/**
+ * Returns the number of lookups that found the position
+ * \return number of successful lookups
+ */
+uint64_t ReversiPersistentCache::getHits() const
+{
+	return hits.load();
+}
+
+/**
+ * Searches all positions of a file to a fixed depth with the cache and
+ * prints the time, the nodes and the hit rate of the cache. A second
+ * run on the same file shows the speed of a warm start
+ * \param const std::string& positionPath	: [IN] file of positions
+ * \param const std::string& cachePath	: [IN] path of the cache file
+ * \param int depth		: [IN] search depth
+ * \param int sizeMb	: [IN] size of a new cache file in megabytes
+ * \return false if a file could not be opened
+ */
+bool ReversiPersistentCache::analyze(const string& positionPath,
+		const string& cachePath, int depth, int sizeMb)
+{
+	vector<ReversiPosition> positions;
+	ReversiPersistentCache cache;
+	if (!ReversiPositionFile::read(positionPath, positions) ||
+			!cache.open(cachePath, sizeMb)){
+		return false;
+	}
+	ReversiEngine engine(0, 0, 64);
+	engine.setPersistentCache(&cache);
+	uint64_t nodes = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (size_t index = 0; index < positions.size(); index++){
+		nodes += engine.searchPosition(positions[index], depth,
+				numeric_limits<int>::max() / 2).nodes;
+	}
+	double seconds = chrono::duration<double>(
+			chrono::steady_clock::now() - start).count();
+	uint64_t probes = cache.getProbes();
+	uint64_t hits = cache.getHits();
+	cout << fixed << setprecision(2);
+	cout << "Searched " << positions.size() << " positions to depth " <<
+			depth << " in " << seconds << " s, " << nodes << " nodes" << endl;
+	cout << "Cache: " << probes << " lookups, " << hits << " hits, hit rate "
+			<< (probes ? 100.0 * hits / probes : 0) << "%" << endl;
+	return true;
+}
+
+/**
+ * Destructor of class ReversiPersistentCache, closes the file
+ */
+ReversiPersistentCache::~ReversiPersistentCache()
+{
+	close();
+}
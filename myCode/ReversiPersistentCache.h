@@ -0,0 +1,166 @@
+/*
+ * ReversiPersistentCache.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIPERSISTENTCACHE_H_
+#define REVERSIPERSISTENTCACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "ReversiHashTable.h"
+#include "ReversiPosition.h"
+
+/**
+ * Position cache in a memory mapped file that keeps search results
+ * across runs. Positions are stored in their canonical form, so all
+ * symmetric positions share one entry, and the best move is stored in
+ * the coordinates of the canonical position.
+ *
+ * The file has a fixed size and is shared: any number of threads and
+ * processes may open it and read and write entries at the same time.
+ * Like in ReversiHashTable every entry holds key XOR data next to the
+ * data, so an entry torn by concurrent writers or by a crash in the
+ * middle of an update fails the check and counts as empty. The file is
+ * created under a temporary name and linked into place when complete,
+ * so a crash during creation never leaves a half-initialized cache
+ */
+class ReversiPersistentCache
+{
+	/**
+	 * First bytes of the file
+	 */
+	struct Header{
+		char magic[8];
+		uint32_t version;
+		uint32_t entrySize;
+		uint64_t bucketCount;
+		uint64_t reserved[5];
+	};
+
+	/**
+	 * One slot of the cache, see ReversiHashTable
+	 */
+	struct Entry{
+		std::atomic<uint64_t> check;
+		std::atomic<uint64_t> data;
+	};
+
+	/**
+	 * Number of entries per bucket, a position may be stored in any entry
+	 * of its bucket. A bucket fills one cache line
+	 */
+	static const int bucketEntries = 4;
+
+	/**
+	 * Start and size of the mapped file, nullptr if no file is open
+	 */
+	void* mapping;
+	size_t mappingSize;
+
+	/**
+	 * First entry after the header
+	 */
+	Entry* pEntries;
+
+	/**
+	 * Number of buckets minus one, used to map a key to a bucket
+	 */
+	uint64_t bucketMask;
+
+	/**
+	 * Lookups and successful lookups since the file was opened, in this
+	 * process only
+	 */
+	std::atomic<uint64_t> probes;
+	std::atomic<uint64_t> hits;
+
+	/**
+	 * Creates a new cache file, if no file of that name exists yet
+	 * \param const std::string& path	: [IN] path of the file
+	 * \param int sizeMb				: [IN] size of the entries in megabytes
+	 * \return false if the file could not be created
+	 */
+	static bool create(const std::string& path, int sizeMb);
+
+public:
+	/**
+	 * Constructor of class ReversiPersistentCache, no file is open
+	 */
+	ReversiPersistentCache();
+
+	/**
+	 * Opens a cache file, creating it if it does not exist
+	 * \param const std::string& path	: [IN] path of the file
+	 * \param int sizeMb	: [IN] size of a new file in megabytes, an
+	 * 						existing file keeps its size
+	 * \return false if the file could not be opened or is no cache file
+	 */
+	bool open(const std::string& path, int sizeMb);
+
+	/**
+	 * Closes the file. The entries written stay in the file
+	 */
+	void close();
+
+	/**
+	 * Looks up a position
+	 * \param const ReversiPosition& position	: [IN] position to look up
+	 * \param int& depth	: [OUT] depth of the stored search
+	 * \param int& score	: [OUT] stored score
+	 * \param ReversiHashTable::BOUND_t& bound	: [OUT] bound type of the
+	 * 						stored score
+	 * \param int& move		: [OUT] stored best move of the position or
+	 * 						ReversiHashTable::noMove
+	 * \return true if the position was found, else false
+	 */
+	bool probe(const ReversiPosition& position, int& depth, int& score,
+			ReversiHashTable::BOUND_t& bound, int& move);
+
+	/**
+	 * Stores the result of a search
+	 * \param const ReversiPosition& position	: [IN] searched position
+	 * \param int depth		: [IN] depth of the search
+	 * \param int score		: [IN] score of the search
+	 * \param ReversiHashTable::BOUND_t bound	: [IN] bound type of the score
+	 * \param int move		: [IN] best move found or ReversiHashTable::noMove
+	 */
+	void store(const ReversiPosition& position, int depth, int score,
+			ReversiHashTable::BOUND_t bound, int move);
+
+	/**
+	 * Returns the number of lookups since the file was opened
+	 * \return number of lookups
+	 */
+	uint64_t getProbes() const;
+
+	/**
+	 * Returns the number of lookups that found the position
+	 * \return number of successful lookups
+	 */
+	uint64_t getHits() const;
+
+	/**
+	 * Searches all positions of a file to a fixed depth with the cache and
+	 * prints the time, the nodes and the hit rate of the cache. A second
+	 * run on the same file shows the speed of a warm start
+	 * \param const std::string& positionPath	: [IN] file of positions
+	 * \param const std::string& cachePath	: [IN] path of the cache file
+	 * \param int depth		: [IN] search depth
+	 * \param int sizeMb	: [IN] size of a new cache file in megabytes
+	 * \return false if a file could not be opened
+	 */
+	static bool analyze(const std::string& positionPath,
+			const std::string& cachePath, int depth, int sizeMb);
+
+	/**
+	 * Destructor of class ReversiPersistentCache, closes the file
+	 */
+	virtual ~ReversiPersistentCache();
+};
+
+#endif /* REVERSIPERSISTENTCACHE_H_ */
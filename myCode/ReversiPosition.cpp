@@ -0,0 +1,323 @@
+/*
+ * ReversiPosition.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include "ReversiPosition.h"
+
+/**
+ * Step of the array index and the mask of fields that may be reached by
+ * the step for each of the 8 directions. The masks drop discs that would
+ * wrap around from one edge of the board to the other
+ */
+static const int directionSteps[8] = {1, -1, 8, -8, 9, -9, 7, -7};
+static const uint64_t directionMasks[8] = {
+		0xFEFEFEFEFEFEFEFEULL, 0x7F7F7F7F7F7F7F7FULL,
+		0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL,
+		0xFEFEFEFEFEFEFEFEULL, 0x7F7F7F7F7F7F7F7FULL,
+		0x7F7F7F7F7F7F7F7FULL, 0xFEFEFEFEFEFEFEFEULL,
+};
+
+/**
+ * Shifts all discs of a bit board one step into a direction, discs
+ * leaving the board are dropped
+ * \param uint64_t discs	: [IN] bit board to shift
+ * \param int direction		: [IN] direction number, 0 to 7
+ * \return shifted bit board
+ */
+static inline uint64_t shift(uint64_t discs, int direction)
+{
+	int step = directionSteps[direction];
+	uint64_t shifted = step > 0 ? discs << step : discs >> -step;
+	return shifted & directionMasks[direction];
+}
+
+/**
+ * Computes all valid moves of the side to move. For every direction the
+ * runs of opponent discs next to own discs are extended step by step, an
+ * empty field behind such a run is a valid move
+ * \param uint64_t player	: [IN] discs of the side to move
+ * \param uint64_t opponent	: [IN] discs of the opponent
+ * \return bit board of all fields the side to move can play
+ */
+uint64_t ReversiPosition::validMoves(uint64_t player, uint64_t opponent)
+{
+	uint64_t moves = 0;
+	for (int direction = 0; direction < 8; direction++){
+		uint64_t run = shift(player, direction) & opponent;
+		for (int step = 0; step < 5; step++){
+			run |= shift(run, direction) & opponent;
+		}
+		moves |= shift(run, direction);
+	}
+	return moves & ~(player | opponent);
+}
+
+/**
+ * Computes the opponent discs flipped by a move
+ * \param uint64_t player	: [IN] discs of the side to move
+ * \param uint64_t opponent	: [IN] discs of the opponent
+ * \param int index			: [IN] array index of the move
+ * \return bit board of the flipped discs, 0 if the move is not valid
+ */
+uint64_t ReversiPosition::flips(uint64_t player, uint64_t opponent,
+		int index)
+{
+	uint64_t move = 1ULL << index;
+	uint64_t flipped = 0;
+	if ((player | opponent) & move){
+		return 0;
+	}
+	for (int direction = 0; direction < 8; direction++){
+		uint64_t line = 0;
+		uint64_t next = shift(move, direction);
+		while (next & opponent){
+			line |= next;
+			next = shift(next, direction);
+		}
+		if (next & player){
+			flipped |= line;
+		}
+	}
+	return flipped;
+}
+
+/**
+ * Computes all valid moves of the side to move
+ * \return bit board of all fields the side to move can play
+ */
+uint64_t ReversiPosition::validMoves() const
+{
+	return validMoves(getPlayer(), opponentWord);
+}
+
+/**
+ * Computes the discs flipped by a move of the side to move
+ * \param int index	: [IN] array index of the move
+ * \return bit board of the flipped discs, 0 if the move is not valid
+ */
+uint64_t ReversiPosition::flips(int index) const
+{
+	return flips(getPlayer(), opponentWord, index);
+}
+
+/**
+ * Plays a move of the side to move, the move has to be valid
+ * \param int index	: [IN] array index of the move
+ * \return position after the move, the other side to move
+ */
+ReversiPosition ReversiPosition::play(int index) const
+{
+	return play(index, flips(index));
+}
+
+/**
+ * Applies a symmetry of the board to a bit board. Bit 2 of the symmetry
+ * mirrors at the diagonal from (1,1) to (8,8), then bit 1 mirrors the
+ * columns and bit 0 the rows. Together they give all rotations and
+ * mirrors
+ * \param uint64_t discs	: [IN] bit board
+ * \param int symmetry		: [IN] symmetry, 0 to symmetryCount - 1,
+ * 						0 leaves the board unchanged
+ * \return transformed bit board
+ */
+uint64_t ReversiPosition::transform(uint64_t discs, int symmetry)
+{
+	if (symmetry & 4){
+		// Swap rows and columns in three steps of swapping blocks
+		uint64_t swap = (discs ^ (discs >> 7)) & 0x00AA00AA00AA00AAULL;
+		discs ^= swap ^ (swap << 7);
+		swap = (discs ^ (discs >> 14)) & 0x0000CCCC0000CCCCULL;
+		discs ^= swap ^ (swap << 14);
+		swap = (discs ^ (discs >> 28)) & 0x00000000F0F0F0F0ULL;
+		discs ^= swap ^ (swap << 28);
+	}
+	if (symmetry & 2){
+		discs = ((discs >> 1) & 0x5555555555555555ULL) |
+				((discs & 0x5555555555555555ULL) << 1);
+		discs = ((discs >> 2) & 0x3333333333333333ULL) |
+				((discs & 0x3333333333333333ULL) << 2);
+		discs = ((discs >> 4) & 0x0F0F0F0F0F0F0F0FULL) |
+				((discs & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	}
+	if (symmetry & 1){
+		discs = __builtin_bswap64(discs);
+	}
+	return discs;
+}
+
+/**
+ * Applies a symmetry of the board to a move
+ * \param int index		: [IN] array index of the move
+ * \param int symmetry	: [IN] symmetry, 0 to symmetryCount - 1
+ * \return array index of the transformed move
+ */
+int ReversiPosition::transformMove(int index, int symmetry)
+{
+	int row = index / 8;
+	int column = index % 8;
+	if (symmetry & 4){
+		int swap = row;
+		row = column;
+		column = swap;
+	}
+	if (symmetry & 2){
+		column = 7 - column;
+	}
+	if (symmetry & 1){
+		row = 7 - row;
+	}
+	return row * 8 + column;
+}
+
+/**
+ * Undoes transformMove by applying its steps in reverse order
+ * \param int index		: [IN] array index of the transformed move
+ * \param int symmetry	: [IN] symmetry used by transformMove
+ * \return array index of the original move
+ */
+int ReversiPosition::untransformMove(int index, int symmetry)
+{
+	int row = index / 8;
+	int column = index % 8;
+	if (symmetry & 1){
+		row = 7 - row;
+	}
+	if (symmetry & 2){
+		column = 7 - column;
+	}
+	if (symmetry & 4){
+		int swap = row;
+		row = column;
+		column = swap;
+	}
+	return row * 8 + column;
+}
+
+/**
+ * Applies a symmetry of the board to the position
+ * \param int symmetry	: [IN] symmetry, 0 to symmetryCount - 1
+ * \return transformed position, same player to move
+ */
+ReversiPosition ReversiPosition::transform(int symmetry) const
+{
+	return create(transform(getPlayer(), symmetry),
+			transform(opponentWord, symmetry), isPlayer1ToMove());
+}
+
+/**
+ * Returns the canonical form of the position: the symmetric position
+ * with the smallest bit boards, compared by the side to move first
+ * \param int& symmetry	: [OUT] symmetry that gives the canonical form
+ * \return canonical position
+ */
+ReversiPosition ReversiPosition::canonical(int& symmetry) const
+{
+	uint64_t player = getPlayer();
+	uint64_t bestPlayer = player;
+	uint64_t bestOpponent = opponentWord;
+	symmetry = 0;
+	for (int candidate = 1; candidate < symmetryCount; candidate++){
+		uint64_t candidatePlayer = transform(player, candidate);
+		if (candidatePlayer > bestPlayer){
+			continue;
+		}
+		uint64_t candidateOpponent = transform(opponentWord, candidate);
+		if (candidatePlayer < bestPlayer || candidateOpponent < bestOpponent){
+			bestPlayer = candidatePlayer;
+			bestOpponent = candidateOpponent;
+			symmetry = candidate;
+		}
+	}
+	return create(bestPlayer, bestOpponent, isPlayer1ToMove());
+}
+
+/**
+ * Writes the position as text: 64 fields in array index order, X for
+ * PLAYER1, O for PLAYER2 and . for empty, a blank and X or O for the
+ * player to move
+ * \return text of the position
+ */
+std::string ReversiPosition::toString() const
+{
+	bool player1 = isPlayer1ToMove();
+	std::string text;
+	for (int index = 0; index < 64; index++){
+		text += (getPlayer() >> index) & 1 ? (player1 ? 'X' : 'O') :
+				(opponentWord >> index) & 1 ? (player1 ? 'O' : 'X') : '.';
+	}
+	text += player1 ? " X" : " O";
+	return text;
+}
+
+/**
+ * Reads a position written by toString. Positions with an empty center
+ * field cannot be stored and are refused
+ * \param const std::string& text	: [IN] text of the position
+ * \param ReversiPosition& position	: [OUT] position read
+ * \return false if the text is no valid position
+ */
+bool ReversiPosition::fromString(const std::string& text,
+		ReversiPosition& position)
+{
+	if (text.size() < 66 || text[64] != ' ' ||
+			(text[65] != 'X' && text[65] != 'O')){
+		return false;
+	}
+	uint64_t player1Discs = 0;
+	uint64_t player2Discs = 0;
+	for (int index = 0; index < 64; index++){
+		if (text[index] == 'X'){
+			player1Discs |= 1ULL << index;
+		}
+		else if (text[index] == 'O'){
+			player2Discs |= 1ULL << index;
+		}
+		else if (text[index] != '.'){
+			return false;
+		}
+	}
+	if (((player1Discs | player2Discs) & 0x0000001818000000ULL) !=
+			0x0000001818000000ULL){
+		return false;
+	}
+	position = text[65] == 'X' ? create(player1Discs, player2Discs, true) :
+			create(player2Discs, player1Discs, false);
+	return true;
+}
+
+/**
+ * Writes a move as column letter a to h and row number 1 to 8, for
+ * example c4 for row 4, column 3
+ * \param int index	: [IN] array index of the move, -1 for a pass
+ * \return name of the move, -- for a pass
+ */
+std::string ReversiPosition::moveToString(int index)
+{
+	if (index < 0 || index >= 64){
+		return "--";
+	}
+	std::string text;
+	text += (char)('a' + index % 8);
+	text += (char)('1' + index / 8);
+	return text;
+}
+
+/**
+ * Reads a move written by moveToString
+ * \param const std::string& text	: [IN] name of the move
+ * \return array index of the move, -1 for a pass, -2 if invalid
+ */
+int ReversiPosition::moveFromString(const std::string& text)
+{
+	if (text == "--"){
+		return -1;
+	}
+	if (text.size() != 2 || text[0] < 'a' || text[0] > 'h' ||
+			text[1] < '1' || text[1] > '8'){
+		return -2;
+	}
+	return (text[1] - '1') * 8 + (text[0] - 'a');
+}
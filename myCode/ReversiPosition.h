@@ -0,0 +1,332 @@
+/*
+ * ReversiPosition.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIPOSITION_H_
+#define REVERSIPOSITION_H_
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/**
+ * Compact position of a Reversi game: the discs of the side to move, the
+ * discs of the other side and which player is to move, in 16 bytes.
+ * Bit i of a bit board stands for the field with array index i of the
+ * ReversiBoard, that is (row - 1) * 8 + (column - 1).
+ *
+ * The four center fields are occupied from the start and can never become
+ * empty again, so whether the side to move owns field (4,4) follows from
+ * the opponent's bit board. That bit of the player's bit board is used to
+ * store if PLAYER1 is to move instead.
+ *
+ * The type is trivially copyable and has no pointers, so positions can be
+ * kept in arrays, hash tables and files and copied with memcpy. Moves
+ * create a new position instead of changing the old one
+ */
+class ReversiPosition
+{
+	/**
+	 * Bit of the center field (4,4) that holds the color to move
+	 */
+	static constexpr uint64_t colorBit = 1ULL << 27;
+
+	/**
+	 * Discs of the side to move, bit 27 replaced by the color to move
+	 */
+	uint64_t playerWord;
+
+	/**
+	 * Discs of the other side
+	 */
+	uint64_t opponentWord;
+
+	/**
+	 * Constructor from the stored words
+	 * \param uint64_t playerWord	: [IN] player word including the color
+	 * \param uint64_t opponentWord	: [IN] discs of the other side
+	 */
+	constexpr ReversiPosition(uint64_t playerWord, uint64_t opponentWord):
+			playerWord(playerWord), opponentWord(opponentWord)
+	{
+	}
+
+	/**
+	 * Last step of the hash function, folds the high bits into the low bits
+	 * \param uint64_t key	: [IN] value to mix
+	 * \return mixed value
+	 */
+	static constexpr uint64_t mixHigh(uint64_t key)
+	{
+		return key ^ (key >> 29);
+	}
+
+	/**
+	 * Second to last step of the hash function, spreads the low bits over
+	 * the whole key
+	 * \param uint64_t key	: [IN] value to mix
+	 * \return mixed value
+	 */
+	static constexpr uint64_t mixLow(uint64_t key)
+	{
+		return mixHigh((key ^ (key >> 31)) * 0xBF58476D1CE4E5B9ULL);
+	}
+
+public:
+	/**
+	 * Default constructor, leaves the position uninitialized like a plain
+	 * struct so that arrays of positions cost nothing to create
+	 */
+	ReversiPosition() = default;
+
+	/**
+	 * Creates a position from two bit boards
+	 * \param uint64_t player	: [IN] discs of the side to move
+	 * \param uint64_t opponent	: [IN] discs of the other side
+	 * \param bool player1		: [IN] true if PLAYER1 is to move
+	 * \return the position
+	 */
+	static constexpr ReversiPosition create(uint64_t player,
+			uint64_t opponent, bool player1)
+	{
+		return ReversiPosition((player & ~colorBit) | (player1 ? colorBit : 0),
+				opponent);
+	}
+
+	/**
+	 * Returns the start position, the same as the one set up by the
+	 * constructor of ReversiBoard with PLAYER1 to move
+	 * \return the start position
+	 */
+	static constexpr ReversiPosition initial()
+	{
+		return create(0x0000001008000000ULL, 0x0000000810000000ULL, true);
+	}
+
+	/**
+	 * Returns the discs of the side to move
+	 * \return bit board of the discs
+	 */
+	constexpr uint64_t getPlayer() const
+	{
+		return (playerWord & ~colorBit) | (colorBit & ~opponentWord);
+	}
+
+	/**
+	 * Returns the discs of the other side
+	 * \return bit board of the discs
+	 */
+	constexpr uint64_t getOpponent() const
+	{
+		return opponentWord;
+	}
+
+	/**
+	 * Returns all occupied fields
+	 * \return bit board of the discs of both sides
+	 */
+	constexpr uint64_t getDiscs() const
+	{
+		return getPlayer() | opponentWord;
+	}
+
+	/**
+	 * Returns which player is to move
+	 * \return true if PLAYER1 is to move, false if PLAYER2 is to move
+	 */
+	constexpr bool isPlayer1ToMove() const
+	{
+		return (playerWord & colorBit) != 0;
+	}
+
+	/**
+	 * Returns the number of empty fields
+	 * \return number of empty fields
+	 */
+	constexpr int getEmptyCount() const
+	{
+		return 64 - __builtin_popcountll(getDiscs());
+	}
+
+	/**
+	 * Returns the disc difference from the view of the side to move
+	 * \return own discs minus discs of the other side
+	 */
+	constexpr int getDiscDifference() const
+	{
+		return __builtin_popcountll(getPlayer()) -
+				__builtin_popcountll(opponentWord);
+	}
+
+	/**
+	 * Plays a move whose flipped discs are already known
+	 * \param int index			: [IN] array index of the move
+	 * \param uint64_t flipped	: [IN] discs flipped by the move
+	 * \return position after the move, the other side to move
+	 */
+	constexpr ReversiPosition play(int index, uint64_t flipped) const
+	{
+		return create(opponentWord & ~flipped,
+				getPlayer() | flipped | (1ULL << index), !isPlayer1ToMove());
+	}
+
+	/**
+	 * Passes the move to the other side
+	 * \return position with the other side to move
+	 */
+	constexpr ReversiPosition pass() const
+	{
+		return create(opponentWord, getPlayer(), !isPlayer1ToMove());
+	}
+
+	/**
+	 * Computes a 64 bit hash key of the position, including the color to
+	 * move
+	 * \return hash key
+	 */
+	constexpr uint64_t hash() const
+	{
+		return mixLow(playerWord * 0x9E3779B97F4A7C15ULL ^
+				(opponentWord + 0x632BE59BD9B4E019ULL) *
+				0xC2B2AE3D27D4EB4FULL);
+	}
+
+	/**
+	 * Compares two positions
+	 * \param const ReversiPosition& other	: [IN] position to compare with
+	 * \return true if discs and color to move are the same
+	 */
+	constexpr bool operator==(const ReversiPosition& other) const
+	{
+		return playerWord == other.playerWord &&
+				opponentWord == other.opponentWord;
+	}
+	constexpr bool operator!=(const ReversiPosition& other) const
+	{
+		return !(*this == other);
+	}
+
+	/**
+	 * Computes all valid moves of the side to move
+	 * \param uint64_t player	: [IN] discs of the side to move
+	 * \param uint64_t opponent	: [IN] discs of the opponent
+	 * \return bit board of all fields the side to move can play
+	 */
+	static uint64_t validMoves(uint64_t player, uint64_t opponent);
+
+	/**
+	 * Computes the opponent discs flipped by a move
+	 * \param uint64_t player	: [IN] discs of the side to move
+	 * \param uint64_t opponent	: [IN] discs of the opponent
+	 * \param int index			: [IN] array index of the move
+	 * \return bit board of the flipped discs, 0 if the move is not valid
+	 */
+	static uint64_t flips(uint64_t player, uint64_t opponent, int index);
+
+	/**
+	 * Computes all valid moves of the side to move
+	 * \return bit board of all fields the side to move can play
+	 */
+	uint64_t validMoves() const;
+
+	/**
+	 * Computes the discs flipped by a move of the side to move
+	 * \param int index	: [IN] array index of the move
+	 * \return bit board of the flipped discs, 0 if the move is not valid
+	 */
+	uint64_t flips(int index) const;
+
+	/**
+	 * Plays a move of the side to move, the move has to be valid
+	 * \param int index	: [IN] array index of the move
+	 * \return position after the move, the other side to move
+	 */
+	ReversiPosition play(int index) const;
+
+	/**
+	 * Number of symmetries of the board: identity, rotations and mirrors
+	 */
+	static const int symmetryCount = 8;
+
+	/**
+	 * Applies a symmetry of the board to a bit board
+	 * \param uint64_t discs	: [IN] bit board
+	 * \param int symmetry		: [IN] symmetry, 0 to symmetryCount - 1,
+	 * 						0 leaves the board unchanged
+	 * \return transformed bit board
+	 */
+	static uint64_t transform(uint64_t discs, int symmetry);
+
+	/**
+	 * Applies a symmetry of the board to a move
+	 * \param int index		: [IN] array index of the move
+	 * \param int symmetry	: [IN] symmetry, 0 to symmetryCount - 1
+	 * \return array index of the transformed move
+	 */
+	static int transformMove(int index, int symmetry);
+
+	/**
+	 * Undoes transformMove
+	 * \param int index		: [IN] array index of the transformed move
+	 * \param int symmetry	: [IN] symmetry used by transformMove
+	 * \return array index of the original move
+	 */
+	static int untransformMove(int index, int symmetry);
+
+	/**
+	 * Applies a symmetry of the board to the position
+	 * \param int symmetry	: [IN] symmetry, 0 to symmetryCount - 1
+	 * \return transformed position, same player to move
+	 */
+	ReversiPosition transform(int symmetry) const;
+
+	/**
+	 * Returns the canonical form of the position: the smallest of its
+	 * symmetric positions. All symmetric positions have the same
+	 * canonical form, so they share one entry in a position cache
+	 * \param int& symmetry	: [OUT] symmetry that gives the canonical form
+	 * \return canonical position
+	 */
+	ReversiPosition canonical(int& symmetry) const;
+
+	/**
+	 * Writes the position as text: 64 fields in array index order, X for
+	 * PLAYER1, O for PLAYER2 and . for empty, a blank and X or O for the
+	 * player to move
+	 * \return text of the position
+	 */
+	std::string toString() const;
+
+	/**
+	 * Reads a position written by toString
+	 * \param const std::string& text	: [IN] text of the position
+	 * \param ReversiPosition& position	: [OUT] position read
+	 * \return false if the text is no valid position
+	 */
+	static bool fromString(const std::string& text, ReversiPosition& position);
+
+	/**
+	 * Writes a move as column letter a to h and row number 1 to 8, for
+	 * example c4 for row 4, column 3
+	 * \param int index	: [IN] array index of the move, -1 for a pass
+	 * \return name of the move, -- for a pass
+	 */
+	static std::string moveToString(int index);
+
+	/**
+	 * Reads a move written by moveToString
+	 * \param const std::string& text	: [IN] name of the move
+	 * \return array index of the move, -1 for a pass, -2 if invalid
+	 */
+	static int moveFromString(const std::string& text);
+};
+
+static_assert(sizeof(ReversiPosition) == 16,
+		"ReversiPosition has to fit into 16 bytes");
+static_assert(std::is_trivially_copyable<ReversiPosition>::value,
+		"ReversiPosition has to be trivially copyable");
+
+#endif /* REVERSIPOSITION_H_ */
@@ -0,0 +1,535 @@
+/*
+ * ReversiPositionDatabase.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include "ReversiGameFile.h"
+#include "ReversiPositionDatabase.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define REVERSIPOSITIONDATABASE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * Magic bytes and version of the file format
+ */
+static const char databaseMagic[8] = {'R', 'V', 'P', 'O', 'S', 'D', 'B', '1'};
+static const uint32_t databaseVersion = 1;
+
+/**
+ * Key of a position in the database
+ * \param const ReversiPosition& position	: [IN] position
+ * \return hash of the canonical form of the position
+ */
+uint64_t ReversiPositionDatabase::key(const ReversiPosition& position)
+{
+	int symmetry;
+	return position.canonical(symmetry).hash();
+}
+
+/**
+ * Writes a sorted run of records to a temporary file
+ * \param std::vector<Record>& records	: [IN] records, sorted and
+ * 										cleared by the call
+ * \param const std::string& path		: [IN] path of the run file
+ * \return false if the file could not be written
+ */
+bool ReversiPositionDatabase::writeRun(vector<Record>& records,
+		const string& path)
+{
+	sort(records.begin(), records.end(), [](const Record& a,
+			const Record& b){
+		return a.hash != b.hash ? a.hash < b.hash :
+				a.game != b.game ? a.game < b.game : a.ply < b.ply;
+	});
+	ofstream file(path.c_str(), ios::binary);
+	file.write((const char*)records.data(), records.size() * sizeof(Record));
+	file.close();
+	records.clear();
+	if (!file){
+		cout << "Cannot write " << path << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Builds a database from a game file. The games are replayed once and
+ * their positions collected; whenever memoryMb megabytes are full they
+ * are sorted and written to a run file. The runs are then merged into
+ * the index, and as the merged records come sorted by hash, the
+ * statistics of each position are summed up on the way. The database is
+ * written under a temporary name and renamed when complete
+ * \param const std::string& gamePath	: [IN] file of games
+ * \param const std::string& path		: [IN] path of the database
+ * \param int memoryMb	: [IN] memory for sorting in megabytes
+ * \return false if a file could not be read or written or a game is
+ * 			invalid
+ */
+bool ReversiPositionDatabase::build(const string& gamePath,
+		const string& path, int memoryMb)
+{
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	ifstream games(gamePath.c_str(), ios::binary);
+	if (!games){
+		cout << "Cannot open " << gamePath << endl;
+		return false;
+	}
+	size_t runSize = (size_t)(memoryMb > 0 ? memoryMb : 1) * 1024 * 1024 /
+			sizeof(Record);
+	vector<Record> records;
+	records.reserve(runSize);
+	vector<string> runPaths;
+	vector<uint64_t> gameOffsets;
+
+	// Removes the run files and the temporary files on every return, the
+	// finished database has been renamed by then
+	struct TemporaryFiles{
+		vector<string> paths;
+		~TemporaryFiles(){
+			for (size_t index = 0; index < paths.size(); index++){
+				remove(paths[index].c_str());
+			}
+		}
+	} temporaryFiles;
+	uint64_t recordCount = 0;
+
+	string line;
+	uint64_t offset = 0;
+	vector<int> moves;
+	vector<ReversiPosition> positions;
+	for (int lineNumber = 1; getline(games, line); lineNumber++){
+		uint64_t lineOffset = offset;
+		offset += line.size() + 1;
+		if (!ReversiGameFile::isGame(line)){
+			continue;
+		}
+		if (!ReversiGameFile::parse(line, moves) ||
+				!ReversiGameFile::replay(moves, positions)){
+			cout << gamePath << ":" << lineNumber << ": invalid game" << endl;
+			return false;
+		}
+		uint32_t game = (uint32_t)gameOffsets.size();
+		gameOffsets.push_back(lineOffset);
+		const ReversiPosition& last = positions.back();
+		int result = last.isPlayer1ToMove() ? last.getDiscDifference() :
+				-last.getDiscDifference();
+		for (size_t ply = 0; ply < positions.size(); ply++){
+			records.push_back(Record{key(positions[ply]), game, (uint8_t)ply,
+					(int8_t)result, 0});
+			if (records.size() == runSize){
+				runPaths.push_back(path + ".run" + to_string(runPaths.size()));
+				temporaryFiles.paths.push_back(runPaths.back());
+				if (!writeRun(records, runPaths.back())){
+					return false;
+				}
+			}
+		}
+		recordCount += positions.size();
+	}
+	runPaths.push_back(path + ".run" + to_string(runPaths.size()));
+	temporaryFiles.paths.push_back(runPaths.back());
+	if (!writeRun(records, runPaths.back())){
+		return false;
+	}
+	records.shrink_to_fit();
+
+	// Merge the runs, each read through a buffer of its own
+	struct Run{
+		ifstream file;
+		vector<Record> buffer;
+		size_t next;
+	};
+	size_t bufferRecords = runSize / runPaths.size() > 4096 ?
+			runSize / runPaths.size() : 4096;
+	vector<unique_ptr<Run>> runs;
+	for (size_t index = 0; index < runPaths.size(); index++){
+		runs.push_back(unique_ptr<Run>(new Run()));
+		runs.back()->file.open(runPaths[index].c_str(), ios::binary);
+		runs.back()->next = 0;
+	}
+	auto fill = [bufferRecords](Run& run){
+		run.buffer.resize(bufferRecords);
+		run.file.read((char*)run.buffer.data(),
+				bufferRecords * sizeof(Record));
+		run.buffer.resize(run.file.gcount() / sizeof(Record));
+		run.next = 0;
+		return !run.buffer.empty();
+	};
+	auto later = [&runs](size_t a, size_t b){
+		const Record& recordA = runs[a]->buffer[runs[a]->next];
+		const Record& recordB = runs[b]->buffer[runs[b]->next];
+		return recordA.hash != recordB.hash ? recordA.hash > recordB.hash :
+				recordA.game != recordB.game ? recordA.game > recordB.game :
+						recordA.ply > recordB.ply;
+	};
+	priority_queue<size_t, vector<size_t>, decltype(later)> heads(later);
+	for (size_t index = 0; index < runs.size(); index++){
+		if (fill(*runs[index])){
+			heads.push(index);
+		}
+	}
+
+	Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, databaseMagic, sizeof(header.magic));
+	header.version = databaseVersion;
+	header.gameCount = gameOffsets.size();
+	header.recordCount = recordCount;
+	header.recordOffset = sizeof(Header) + gameOffsets.size() *
+			sizeof(uint64_t);
+	header.statisticsOffset = header.recordOffset + recordCount *
+			sizeof(Record);
+
+	string tempPath = path + ".tmp";
+	string statisticsPath = path + ".statistics";
+	temporaryFiles.paths.push_back(tempPath);
+	temporaryFiles.paths.push_back(statisticsPath);
+	ofstream database(tempPath.c_str(), ios::binary);
+	ofstream statisticsFile(statisticsPath.c_str(), ios::binary);
+	database.write((const char*)&header, sizeof(header));
+	database.write((const char*)gameOffsets.data(),
+			gameOffsets.size() * sizeof(uint64_t));
+	vector<Record> output;
+	output.reserve(4096);
+	StatisticsRecord current;
+	memset(&current, 0, sizeof(current));
+	uint64_t statisticsCount = 0;
+	while (!heads.empty()){
+		size_t index = heads.top();
+		heads.pop();
+		Run& run = *runs[index];
+		const Record record = run.buffer[run.next++];
+		if (run.next < run.buffer.size() || fill(run)){
+			heads.push(index);
+		}
+
+		output.push_back(record);
+		if (output.size() == output.capacity()){
+			database.write((const char*)output.data(),
+					output.size() * sizeof(Record));
+			output.clear();
+		}
+		if (current.statistics.games != 0 && current.hash != record.hash){
+			statisticsFile.write((const char*)&current, sizeof(current));
+			statisticsCount++;
+			memset(&current, 0, sizeof(current));
+		}
+		current.hash = record.hash;
+		current.statistics.games++;
+		current.statistics.player1Wins += record.result > 0;
+		current.statistics.draws += record.result == 0;
+		current.statistics.player1Losses += record.result < 0;
+		current.statistics.discDifferenceSum += record.result;
+	}
+	if (current.statistics.games != 0){
+		statisticsFile.write((const char*)&current, sizeof(current));
+		statisticsCount++;
+	}
+	database.write((const char*)output.data(),
+			output.size() * sizeof(Record));
+	statisticsFile.close();
+	runs.clear();
+	for (size_t index = 0; index < runPaths.size(); index++){
+		remove(runPaths[index].c_str());
+	}
+
+	// Append the statistics and complete the header
+	ifstream statisticsInput(statisticsPath.c_str(), ios::binary);
+	database << statisticsInput.rdbuf();
+	statisticsInput.close();
+	header.statisticsCount = statisticsCount;
+	header.fileSize = header.statisticsOffset + statisticsCount *
+			sizeof(StatisticsRecord);
+	database.seekp(0);
+	database.write((const char*)&header, sizeof(header));
+	database.close();
+	if (!database || !statisticsFile ||
+			rename(tempPath.c_str(), path.c_str()) != 0){
+		cout << "Cannot write " << path << endl;
+		return false;
+	}
+	double seconds = chrono::duration<double>(
+			chrono::steady_clock::now() - start).count();
+	cout << fixed << setprecision(2);
+	cout << "Indexed " << header.gameCount << " games, " << recordCount <<
+			" positions, " << statisticsCount << " different positions in " <<
+			seconds << " s using " << runPaths.size() << " runs" << endl;
+	return true;
+}
+
+/**
+ * Constructor of class ReversiPositionDatabase, no file is open
+ */
+ReversiPositionDatabase::ReversiPositionDatabase(): mapping(nullptr),
+		mappingSize(0), pHeader(nullptr), pGameOffsets(nullptr),
+		pRecords(nullptr), pStatistics(nullptr)
+{
+}
+
+#ifdef REVERSIPOSITIONDATABASE_MMAP
+
+/**
+ * Opens a database file for queries. The file is mapped read only and
+ * the header is checked against its size
+ * \param const std::string& path	: [IN] path of the database
+ * \return false if the file could not be opened or is no database
+ */
+bool ReversiPositionDatabase::open(const string& path)
+{
+	close();
+	int fd = ::open(path.c_str(), O_RDONLY);
+	struct stat status;
+	if (fd < 0 || fstat(fd, &status) != 0 ||
+			(size_t)status.st_size < sizeof(Header)){
+		cout << "Cannot open " << path << endl;
+		if (fd >= 0){
+			::close(fd);
+		}
+		return false;
+	}
+	mappingSize = (size_t)status.st_size;
+	void* address = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (address == MAP_FAILED){
+		cout << "Cannot map " << path << endl;
+		return false;
+	}
+	mapping = address;
+	pHeader = (const Header*)mapping;
+	if (memcmp(pHeader->magic, databaseMagic, sizeof(databaseMagic)) != 0 ||
+			pHeader->version != databaseVersion ||
+			pHeader->fileSize != mappingSize ||
+			pHeader->recordOffset != sizeof(Header) + pHeader->gameCount *
+					sizeof(uint64_t) ||
+			pHeader->statisticsOffset != pHeader->recordOffset +
+					pHeader->recordCount * sizeof(Record) ||
+			pHeader->fileSize != pHeader->statisticsOffset +
+					pHeader->statisticsCount * sizeof(StatisticsRecord)){
+		cout << path << " is no valid position database" << endl;
+		close();
+		return false;
+	}
+	pGameOffsets = (const uint64_t*)((const char*)mapping + sizeof(Header));
+	pRecords = (const Record*)((const char*)mapping + pHeader->recordOffset);
+	pStatistics = (const StatisticsRecord*)((const char*)mapping +
+			pHeader->statisticsOffset);
+	return true;
+}
+
+/**
+ * Closes the database file
+ */
+void ReversiPositionDatabase::close()
+{
+	if (mapping){
+		munmap(mapping, mappingSize);
+	}
+	mapping = nullptr;
+	mappingSize = 0;
+	pHeader = nullptr;
+	pGameOffsets = nullptr;
+	pRecords = nullptr;
+	pStatistics = nullptr;
+}
+
+#else
+
+/**
+ * Opens a database file, not available without mmap
+ * \param const std::string& path	: [IN] path of the database
+ * \return false
+ */
+bool ReversiPositionDatabase::open(const string& path)
+{
+	cout << "The position database is only available on POSIX systems" <<
+			endl;
+	return false;
+}
+
+/**
+ * Closes the database file
+ */
+void ReversiPositionDatabase::close()
+{
+}
+
+#endif
+
+/**
+ * Returns the number of games in the database
+ * \return number of games
+ */
+uint64_t ReversiPositionDatabase::getGameCount() const
+{
+	return pHeader ? pHeader->gameCount : 0;
+}
+
+/**
+ * Returns where a game starts in the game file
+ * \param uint32_t game	: [IN] number of the game
+ * \return byte offset of the game's line
+ */
+uint64_t ReversiPositionDatabase::getGameOffset(uint32_t game) const
+{
+	return game < getGameCount() ? pGameOffsets[game] : 0;
+}
+
+/**
+ * Looks up the statistics of a position by binary search
+ * \param const ReversiPosition& position	: [IN] position to look up
+ * \param Statistics& statistics	: [OUT] statistics of the position
+ * \return false if no game reached the position
+ */
+bool ReversiPositionDatabase::getStatistics(const ReversiPosition& position,
+		Statistics& statistics) const
+{
+	if (!pHeader){
+		return false;
+	}
+	uint64_t hash = key(position);
+	const StatisticsRecord* pEnd = pStatistics + pHeader->statisticsCount;
+	const StatisticsRecord* pFound = lower_bound(pStatistics, pEnd, hash,
+			[](const StatisticsRecord& record, uint64_t hash){
+		return record.hash < hash;
+	});
+	if (pFound == pEnd || pFound->hash != hash){
+		return false;
+	}
+	statistics = pFound->statistics;
+	return true;
+}
+
+/**
+ * Looks up the games that reached a position by binary search
+ * \param const ReversiPosition& position	: [IN] position to look up
+ * \param std::vector<Occurrence>& occurrences	: [OUT] first games
+ * 					that reached the position, in the order of the file
+ * \param size_t limit	: [IN] maximum number of occurrences returned
+ * \return number of games that reached the position, may be more than
+ * 			limit
+ */
+size_t ReversiPositionDatabase::findGames(const ReversiPosition& position,
+		vector<Occurrence>& occurrences, size_t limit) const
+{
+	occurrences.clear();
+	if (!pHeader){
+		return 0;
+	}
+	uint64_t hash = key(position);
+	const Record* pEnd = pRecords + pHeader->recordCount;
+	const Record* pFirst = lower_bound(pRecords, pEnd, hash,
+			[](const Record& record, uint64_t hash){
+		return record.hash < hash;
+	});
+	const Record* pLast = upper_bound(pFirst, pEnd, hash,
+			[](uint64_t hash, const Record& record){
+		return hash < record.hash;
+	});
+	for (const Record* pRecord = pFirst; pRecord < pLast &&
+			occurrences.size() < limit; pRecord++){
+		occurrences.push_back(Occurrence{pRecord->game, pRecord->ply});
+	}
+	return (size_t)(pLast - pFirst);
+}
+
+/**
+ * Answers a query from the command line and prints the statistics, the
+ * games with their moves up to the position and the time taken by the
+ * lookups
+ * \param const std::string& path		: [IN] path of the database
+ * \param const std::string& gamePath	: [IN] game file the database
+ * 								was built from, empty to print no moves
+ * \param const std::string& query		: [IN] moves from the start
+ * 								position or a position as text
+ * \param size_t limit	: [IN] maximum number of games printed
+ * \return false if a file could not be opened or the query is invalid
+ */
+bool ReversiPositionDatabase::query(const string& path,
+		const string& gamePath, const string& query, size_t limit)
+{
+	ReversiPosition position;
+	if (!ReversiPosition::fromString(query, position)){
+		vector<int> moves;
+		vector<ReversiPosition> positions;
+		if (!ReversiGameFile::parse(query, moves) ||
+				!ReversiGameFile::replay(moves, positions)){
+			cout << "Invalid position or moves: " << query << endl;
+			return false;
+		}
+		position = positions.back();
+	}
+	ReversiPositionDatabase database;
+	if (!database.open(path)){
+		return false;
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	Statistics statistics;
+	bool found = database.getStatistics(position, statistics);
+	vector<Occurrence> occurrences;
+	database.findGames(position, occurrences, limit);
+	double microseconds = chrono::duration<double, micro>(
+			chrono::steady_clock::now() - start).count();
+
+	cout << position.toString() << endl;
+	if (!found){
+		cout << "No game reached the position" << endl;
+	}
+	else{
+		cout << fixed << setprecision(2);
+		cout << "Games: " << statistics.games << ", PLAYER1 wins " <<
+				statistics.player1Wins << ", draws " << statistics.draws <<
+				", PLAYER1 losses " << statistics.player1Losses <<
+				", mean disc difference " << (double)
+				statistics.discDifferenceSum / statistics.games << endl;
+	}
+	ifstream games;
+	if (!gamePath.empty()){
+		games.open(gamePath.c_str(), ios::binary);
+	}
+	for (size_t index = 0; index < occurrences.size(); index++){
+		cout << "Game " << occurrences[index].game << " ply " <<
+				occurrences[index].ply;
+		string line;
+		vector<int> moves;
+		if (games.is_open()){
+			games.clear();
+			games.seekg(database.getGameOffset(occurrences[index].game));
+			if (getline(games, line) && ReversiGameFile::parse(line, moves) &&
+					moves.size() >= occurrences[index].ply){
+				moves.resize(occurrences[index].ply);
+				cout << ": " << ReversiGameFile::format(moves);
+			}
+		}
+		cout << endl;
+	}
+	cout << fixed << setprecision(1) << "Lookup took " << microseconds <<
+			" us" << endl;
+	return true;
+}
+
+/**
+ * Destructor of class ReversiPositionDatabase, closes the file
+ */
+ReversiPositionDatabase::~ReversiPositionDatabase()
+{
+	close();
+}
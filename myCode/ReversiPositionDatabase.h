@@ -0,0 +1,208 @@
+/*
+ * ReversiPositionDatabase.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIPOSITIONDATABASE_H_
+#define REVERSIPOSITIONDATABASE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ReversiPosition.h"
+
+/**
+ * Database of the positions reached in a file of games. The builder
+ * replays every game once and writes one file with
+ *
+ *   - the start offset of every game in the game file,
+ *   - an index of all positions: (hash, game, ply), sorted by hash,
+ *   - statistics per position: number of games, results and the sum of
+ *     the final disc differences, sorted by hash.
+ *
+ * Positions are looked up by the hash of their canonical form, so a
+ * query also finds the games that reached a symmetric position. Queries
+ * map the file into memory and find positions by binary search, only
+ * the pages touched are read from disk
+ */
+class ReversiPositionDatabase
+{
+public:
+	/**
+	 * One occurrence of a position: the game, counted from 0 in the order
+	 * of the game file, and the number of moves played before
+	 */
+	struct Occurrence{
+		uint32_t game;
+		uint32_t ply;
+	};
+
+	/**
+	 * Statistics of a position over all games that reached it. Results
+	 * are from the view of PLAYER1
+	 */
+	struct Statistics{
+		uint32_t games;
+		uint32_t player1Wins;
+		uint32_t draws;
+		uint32_t player1Losses;
+		int64_t discDifferenceSum;
+	};
+
+private:
+	/**
+	 * First bytes of the file, followed by the game offsets, the index
+	 * and the statistics
+	 */
+	struct Header{
+		char magic[8];
+		uint32_t version;
+		uint32_t reserved;
+		uint64_t gameCount;
+		uint64_t recordCount;
+		uint64_t statisticsCount;
+		uint64_t recordOffset;
+		uint64_t statisticsOffset;
+		uint64_t fileSize;
+	};
+
+	/**
+	 * Entry of the index. The final disc difference of the game is kept
+	 * for the statistics, which are made from the sorted index
+	 */
+	struct Record{
+		uint64_t hash;
+		uint32_t game;
+		uint8_t ply;
+		int8_t result;
+		uint16_t reserved;
+	};
+
+	/**
+	 * Statistics of one position in the file
+	 */
+	struct StatisticsRecord{
+		uint64_t hash;
+		Statistics statistics;
+	};
+
+	/**
+	 * Start and size of the mapped file, nullptr if no file is open
+	 */
+	void* mapping;
+	size_t mappingSize;
+
+	/**
+	 * Sections of the mapped file
+	 */
+	const Header* pHeader;
+	const uint64_t* pGameOffsets;
+	const Record* pRecords;
+	const StatisticsRecord* pStatistics;
+
+	/**
+	 * Writes a sorted run of records to a temporary file
+	 * \param std::vector<Record>& records	: [IN] records, sorted and
+	 * 										cleared by the call
+	 * \param const std::string& path		: [IN] path of the run file
+	 * \return false if the file could not be written
+	 */
+	static bool writeRun(std::vector<Record>& records,
+			const std::string& path);
+
+public:
+	/**
+	 * Key of a position in the database
+	 * \param const ReversiPosition& position	: [IN] position
+	 * \return hash of the canonical form of the position
+	 */
+	static uint64_t key(const ReversiPosition& position);
+
+	/**
+	 * Builds a database from a game file. The index is sorted in runs of
+	 * at most memoryMb megabytes that are merged into the database, so the
+	 * game file may be much larger than the memory
+	 * \param const std::string& gamePath	: [IN] file of games
+	 * \param const std::string& path		: [IN] path of the database
+	 * \param int memoryMb	: [IN] memory for sorting in megabytes
+	 * \return false if a file could not be read or written or a game is
+	 * 			invalid
+	 */
+	static bool build(const std::string& gamePath, const std::string& path,
+			int memoryMb);
+
+	/**
+	 * Constructor of class ReversiPositionDatabase, no file is open
+	 */
+	ReversiPositionDatabase();
+
+	/**
+	 * Opens a database file for queries
+	 * \param const std::string& path	: [IN] path of the database
+	 * \return false if the file could not be opened or is no database
+	 */
+	bool open(const std::string& path);
+
+	/**
+	 * Closes the database file
+	 */
+	void close();
+
+	/**
+	 * Returns the number of games in the database
+	 * \return number of games
+	 */
+	uint64_t getGameCount() const;
+
+	/**
+	 * Returns where a game starts in the game file
+	 * \param uint32_t game	: [IN] number of the game
+	 * \return byte offset of the game's line
+	 */
+	uint64_t getGameOffset(uint32_t game) const;
+
+	/**
+	 * Looks up the statistics of a position
+	 * \param const ReversiPosition& position	: [IN] position to look up
+	 * \param Statistics& statistics	: [OUT] statistics of the position
+	 * \return false if no game reached the position
+	 */
+	bool getStatistics(const ReversiPosition& position,
+			Statistics& statistics) const;
+
+	/**
+	 * Looks up the games that reached a position
+	 * \param const ReversiPosition& position	: [IN] position to look up
+	 * \param std::vector<Occurrence>& occurrences	: [OUT] first games
+	 * 					that reached the position, in the order of the file
+	 * \param size_t limit	: [IN] maximum number of occurrences returned
+	 * \return number of games that reached the position, may be more than
+	 * 			limit
+	 */
+	size_t findGames(const ReversiPosition& position,
+			std::vector<Occurrence>& occurrences, size_t limit) const;
+
+	/**
+	 * Answers a query from the command line and prints the statistics, the
+	 * games with their moves up to the position and the time taken
+	 * \param const std::string& path		: [IN] path of the database
+	 * \param const std::string& gamePath	: [IN] game file the database
+	 * 								was built from, empty to print no moves
+	 * \param const std::string& query		: [IN] moves from the start
+	 * 								position or a position as text
+	 * \param size_t limit	: [IN] maximum number of games printed
+	 * \return false if a file could not be opened or the query is invalid
+	 */
+	static bool query(const std::string& path, const std::string& gamePath,
+			const std::string& query, size_t limit);
+
+	/**
+	 * Destructor of class ReversiPositionDatabase, closes the file
+	 */
+	virtual ~ReversiPositionDatabase();
+};
+
+#endif /* REVERSIPOSITIONDATABASE_H_ */
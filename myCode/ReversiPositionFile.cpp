@@ -0,0 +1,113 @@
+/*
+ * ReversiPositionFile.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include "ReversiPositionFile.h"
+using namespace std;
+
+/**
+ * Reads all positions of a file
+ * \param const std::string& path			: [IN] path of the file
+ * \param std::vector<ReversiPosition>& positions	: [OUT] positions read
+ * \return false if the file could not be read or has an invalid line
+ */
+bool ReversiPositionFile::read(const string& path,
+		vector<ReversiPosition>& positions)
+{
+	ifstream file(path.c_str());
+	if (!file){
+		cout << "Cannot open " << path << endl;
+		return false;
+	}
+	positions.clear();
+	string line;
+	for (int lineNumber = 1; getline(file, line); lineNumber++){
+		if (line.empty() || line[0] == '#'){
+			continue;
+		}
+		ReversiPosition position;
+		if (!ReversiPosition::fromString(line, position)){
+			cout << path << ":" << lineNumber << ": invalid position" << endl;
+			return false;
+		}
+		positions.push_back(position);
+	}
+	return true;
+}
+
+/**
+ * Writes positions to a file, replacing its contents
+ * \param const std::string& path	: [IN] path of the file
+ * \param const std::vector<ReversiPosition>& positions	: [IN] positions
+ * \return false if the file could not be written
+ */
+bool ReversiPositionFile::write(const string& path,
+		const vector<ReversiPosition>& positions)
+{
+	ofstream file(path.c_str());
+	for (size_t index = 0; index < positions.size(); index++){
+		file << positions[index].toString() << '\n';
+	}
+	file.close();
+	if (!file){
+		cout << "Cannot write " << path << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Creates positions from random games. Each game gives at most one
+ * position, taken at a random number of empty fields in the range
+ * given, in which the side to move has a valid move. Games that pass
+ * the number of empty fields without a valid move are dropped
+ * \param int count			: [IN] number of positions
+ * \param int minEmpties	: [IN] fewest empty fields
+ * \param int maxEmpties	: [IN] most empty fields
+ * \param uint32_t seed		: [IN] seed of the random games
+ * \return the positions
+ */
+vector<ReversiPosition> ReversiPositionFile::generate(int count,
+		int minEmpties, int maxEmpties, uint32_t seed)
+{
+	vector<ReversiPosition> positions;
+	mt19937 random(seed);
+	if (minEmpties < 1){
+		minEmpties = 1;
+	}
+	if (maxEmpties > 60){
+		maxEmpties = 60;
+	}
+	if (minEmpties > maxEmpties){
+		return positions;
+	}
+	while ((int)positions.size() < count){
+		int empties = minEmpties + random() % (maxEmpties - minEmpties + 1);
+		ReversiPosition position = ReversiPosition::initial();
+		while (position.getEmptyCount() > empties){
+			uint64_t moves = position.validMoves();
+			if (moves == 0){
+				position = position.pass();
+				moves = position.validMoves();
+				if (moves == 0){
+					break;
+				}
+			}
+			for (int skip = random() % __builtin_popcountll(moves); skip > 0;
+					skip--){
+				moves &= moves - 1;
+			}
+			position = position.play(__builtin_ctzll(moves));
+		}
+		if (position.getEmptyCount() == empties && position.validMoves()){
+			positions.push_back(position);
+		}
+	}
+	return positions;
+}
@@ -0,0 +1,56 @@
+/*
+ * ReversiPositionFile.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIPOSITIONFILE_H_
+#define REVERSIPOSITIONFILE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ReversiPosition.h"
+
+/**
+ * Text files of positions, one position per line in the format of
+ * ReversiPosition::toString. Empty lines and lines starting with # are
+ * ignored. Used as input of the calibration, benchmark and solver tools
+ */
+class ReversiPositionFile
+{
+public:
+	/**
+	 * Reads all positions of a file
+	 * \param const std::string& path			: [IN] path of the file
+	 * \param std::vector<ReversiPosition>& positions	: [OUT] positions read
+	 * \return false if the file could not be read or has an invalid line
+	 */
+	static bool read(const std::string& path,
+			std::vector<ReversiPosition>& positions);
+
+	/**
+	 * Writes positions to a file, replacing its contents
+	 * \param const std::string& path	: [IN] path of the file
+	 * \param const std::vector<ReversiPosition>& positions	: [IN] positions
+	 * \return false if the file could not be written
+	 */
+	static bool write(const std::string& path,
+			const std::vector<ReversiPosition>& positions);
+
+	/**
+	 * Creates positions from random games. Each game gives at most one
+	 * position, taken at a random number of empty fields in the range
+	 * given, in which the side to move has a valid move
+	 * \param int count			: [IN] number of positions
+	 * \param int minEmpties	: [IN] fewest empty fields
+	 * \param int maxEmpties	: [IN] most empty fields
+	 * \param uint32_t seed		: [IN] seed of the random games
+	 * \return the positions
+	 */
+	static std::vector<ReversiPosition> generate(int count, int minEmpties,
+			int maxEmpties, uint32_t seed);
+};
+
+#endif /* REVERSIPOSITIONFILE_H_ */
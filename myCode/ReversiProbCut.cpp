@@ -0,0 +1,385 @@
+/*
+ * ReversiProbCut.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+#include "ReversiEngine.h"
+#include "ReversiPositionFile.h"
+#include "ReversiProbCut.h"
+using namespace std;
+
+/**
+ * Fewest samples a regression needs to be used
+ */
+static const int minSamples = 8;
+
+/**
+ * Constructor of class ReversiProbCut without any parameters, nothing
+ * is cut until parameters are loaded
+ */
+ReversiProbCut::ReversiProbCut()
+{
+	for (int stage = 0; stage < stageCount; stage++){
+		for (int depth = 0; depth <= maxDepth; depth++){
+			for (int check = 0; check < checkCount; check++){
+				parameters[stage][depth][check] = Parameters{1, 0, 0, 0};
+			}
+		}
+	}
+}
+
+/**
+ * Returns the game stage of a position
+ * \param int empties	: [IN] number of empty fields
+ * \return stage, 0 to stageCount - 1
+ */
+int ReversiProbCut::getStage(int empties)
+{
+	int stage = (empties - 1) / 10;
+	return stage < 0 ? 0 : stage >= stageCount ? stageCount - 1 : stage;
+}
+
+/**
+ * Returns the depth of a shallow search used to predict a deep search.
+ * The first check costs little and cuts the clear cases, the second one
+ * searches half the depth and predicts better
+ * \param int depth	: [IN] depth of the deep search
+ * \param int check	: [IN] number of the check, 0 to checkCount - 1
+ * \return shallow depth or -1 if the deep depth has no such check
+ */
+int ReversiProbCut::getCheckDepth(int depth, int check)
+{
+	if (depth < minDepth || depth > maxDepth){
+		return -1;
+	}
+	if (check == 0){
+		return depth / 4;
+	}
+	if (check == 1 && depth >= 6){
+		return depth / 2;
+	}
+	return -1;
+}
+
+/**
+ * Converts a confidence level to the number of standard deviations a
+ * prediction has to lie outside the search window, the inverse of the
+ * standard normal distribution found by bisection
+ * \param double confidence	: [IN] probability of a correct cut,
+ * 							between 0.5 and 1
+ * \return number of standard deviations
+ */
+double ReversiProbCut::confidenceToSigmas(double confidence)
+{
+	double low = 0;
+	double high = 8;
+	for (int step = 0; step < 50; step++){
+		double middle = (low + high) / 2;
+		if (0.5 * erfc(-middle / sqrt(2.0)) < confidence){
+			low = middle;
+		}
+		else{
+			high = middle;
+		}
+	}
+	return low;
+}
+
+/**
+ * Returns the parameters of a check
+ * \param int empties	: [IN] number of empty fields
+ * \param int depth		: [IN] depth of the deep search
+ * \param int check		: [IN] number of the check
+ * \param double& a		: [OUT] slope of the prediction
+ * \param double& b		: [OUT] offset of the prediction
+ * \param double& sigma	: [OUT] standard deviation of the error
+ * \return false if there are no parameters for the check
+ */
+bool ReversiProbCut::getParameters(int empties, int depth, int check,
+		double& a, double& b, double& sigma) const
+{
+	if (getCheckDepth(depth, check) < 0){
+		return false;
+	}
+	const Parameters& fit = parameters[getStage(empties)][depth][check];
+	a = fit.a;
+	b = fit.b;
+	sigma = fit.sigma;
+	return fit.samples != 0;
+}
+
+/**
+ * Reads the parameters from a file written by save. Each line holds
+ * stage, deep depth, check, shallow depth, a, b, sigma and the number of
+ * samples, lines starting with # are comments
+ * \param const std::string& path	: [IN] path of the file
+ * \return false if the file could not be read or is invalid
+ */
+bool ReversiProbCut::load(const string& path)
+{
+	ifstream file(path.c_str());
+	if (!file){
+		cout << "Cannot open " << path << endl;
+		return false;
+	}
+	*this = ReversiProbCut();
+	string line;
+	for (int lineNumber = 1; getline(file, line); lineNumber++){
+		if (line.empty() || line[0] == '#'){
+			continue;
+		}
+		istringstream fields(line);
+		int stage;
+		int depth;
+		int check;
+		int shallowDepth;
+		Parameters fit;
+		if (!(fields >> stage >> depth >> check >> shallowDepth >> fit.a >>
+				fit.b >> fit.sigma >> fit.samples) || stage < 0 ||
+				stage >= stageCount || check < 0 || check >= checkCount ||
+				getCheckDepth(depth, check) != shallowDepth || fit.a <= 0 ||
+				fit.sigma < 0 || fit.samples <= 0){
+			cout << path << ":" << lineNumber << ": invalid parameters" <<
+					endl;
+			return false;
+		}
+		parameters[stage][depth][check] = fit;
+	}
+	return true;
+}
+
+/**
+ * Writes the parameters to a file
+ * \param const std::string& path	: [IN] path of the file
+ * \return false if the file could not be written
+ */
+bool ReversiProbCut::save(const string& path) const
+{
+	ofstream file(path.c_str());
+	file << "# Multi-ProbCut parameters, deep score = a * shallow score + b"
+			<< '\n';
+	file << "# stage depth check shallow a b sigma samples" << '\n';
+	file << fixed;
+	for (int stage = 0; stage < stageCount; stage++){
+		for (int depth = minDepth; depth <= maxDepth; depth++){
+			for (int check = 0; check < checkCount; check++){
+				const Parameters& fit = parameters[stage][depth][check];
+				if (fit.samples == 0){
+					continue;
+				}
+				file << stage << ' ' << depth << ' ' << check << ' ' <<
+						getCheckDepth(depth, check) << ' ' <<
+						setprecision(4) << fit.a << ' ' << setprecision(1) <<
+						fit.b << ' ' << fit.sigma << ' ' << fit.samples <<
+						'\n';
+			}
+		}
+	}
+	file.close();
+	if (!file){
+		cout << "Cannot write " << path << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Fits the parameters: every position is searched full-width to all
+ * depths up to searchDepth and the scores of each pair of depths are
+ * put through a linear regression. Positions whose search would reach
+ * the end of the game are skipped, their deep scores are exact and do
+ * not follow the regression
+ * \param const std::string& positionPath	: [IN] file of positions
+ * \param const std::string& dataPath		: [IN] file for the parameters
+ * \param int searchDepth	: [IN] deepest depth to fit
+ * \return false if a file could not be read or written
+ */
+bool ReversiProbCut::calibrate(const string& positionPath,
+		const string& dataPath, int searchDepth)
+{
+	vector<ReversiPosition> positions;
+	if (!ReversiPositionFile::read(positionPath, positions)){
+		return false;
+	}
+	if (searchDepth > maxDepth){
+		searchDepth = maxDepth;
+	}
+
+	// Sums of the shallow scores x and deep scores y per stage and depth
+	struct Sums{
+		double n, x, y, xx, xy, yy;
+	};
+	vector<Sums> sums(stageCount * (maxDepth + 1) * checkCount,
+			Sums{0, 0, 0, 0, 0, 0});
+	ReversiEngine engine(0, 0, 64);
+	int used = 0;
+	for (size_t index = 0; index < positions.size(); index++){
+		const ReversiPosition& position = positions[index];
+		int empties = position.getEmptyCount();
+		if (empties <= searchDepth || position.validMoves() == 0){
+			continue;
+		}
+		vector<int> scores(searchDepth + 1);
+		for (int depth = 0; depth <= searchDepth; depth++){
+			scores[depth] = engine.scorePosition(position, depth);
+		}
+		int stage = getStage(empties);
+		for (int depth = minDepth; depth <= searchDepth; depth++){
+			for (int check = 0; check < checkCount; check++){
+				int shallowDepth = getCheckDepth(depth, check);
+				if (shallowDepth < 0){
+					continue;
+				}
+				Sums& sum = sums[(stage * (maxDepth + 1) + depth) *
+						checkCount + check];
+				double x = scores[shallowDepth];
+				double y = scores[depth];
+				sum.n++;
+				sum.x += x;
+				sum.y += y;
+				sum.xx += x * x;
+				sum.xy += x * y;
+				sum.yy += y * y;
+			}
+		}
+		used++;
+		cout << "\rCalibrated " << used << " positions" << flush;
+	}
+	cout << endl;
+
+	ReversiProbCut probCut;
+	for (int stage = 0; stage < stageCount; stage++){
+		for (int depth = minDepth; depth <= searchDepth; depth++){
+			for (int check = 0; check < checkCount; check++){
+				const Sums& sum = sums[(stage * (maxDepth + 1) + depth) *
+						checkCount + check];
+				if (sum.n < minSamples){
+					continue;
+				}
+				double varianceX = sum.xx / sum.n - (sum.x / sum.n) *
+						(sum.x / sum.n);
+				double covariance = sum.xy / sum.n - (sum.x / sum.n) *
+						(sum.y / sum.n);
+				if (varianceX <= 0 || covariance <= 0){
+					continue;
+				}
+				Parameters fit;
+				fit.a = covariance / varianceX;
+				fit.b = (sum.y - fit.a * sum.x) / sum.n;
+				// Residual variance of y around the fitted line
+				double residual = (sum.yy - 2 * fit.a * sum.xy - 2 * fit.b *
+						sum.y + fit.a * fit.a * sum.xx + 2 * fit.a * fit.b *
+						sum.x + fit.b * fit.b * sum.n) / (sum.n - 2);
+				fit.sigma = sqrt(residual > 0 ? residual : 0);
+				fit.samples = (int)sum.n;
+				probCut.parameters[stage][depth][check] = fit;
+			}
+		}
+	}
+	cout << "Used " << used << " of " << positions.size() << " positions" <<
+			endl;
+	return probCut.save(dataPath);
+}
+
+/**
+ * Compares the selective search with the full-width search on a set
+ * of positions. First both search every position for budgetMs and the
+ * average depth reached is printed, the effective depth of the selective
+ * search. Then both search every position to the given depth and the
+ * rate of different best moves, the mean score error and the share of
+ * nodes and time needed by the selective search are printed
+ * \param const std::string& positionPath	: [IN] file of positions
+ * \param const std::string& dataPath		: [IN] file of the parameters
+ * \param int depth				: [IN] depth of the comparison
+ * \param double confidence		: [IN] confidence level of the cuts
+ * \param int budgetMs			: [IN] time per position for the depth
+ * 								comparison
+ * \return false if a file could not be read
+ */
+bool ReversiProbCut::benchmark(const string& positionPath,
+		const string& dataPath, int depth, double confidence, int budgetMs)
+{
+	vector<ReversiPosition> positions;
+	ReversiProbCut probCut;
+	if (!ReversiPositionFile::read(positionPath, positions) ||
+			!probCut.load(dataPath)){
+		return false;
+	}
+	ReversiEngine fullEngine(0, 0, 64);
+	ReversiEngine selectiveEngine(0, 0, 64);
+	selectiveEngine.setProbCut(&probCut, confidence);
+
+	double fullDepths = 0;
+	double selectiveDepths = 0;
+	int timed = 0;
+	int compared = 0;
+	int moveErrors = 0;
+	double scoreErrors = 0;
+	double fullNodes = 0;
+	double selectiveNodes = 0;
+	double fullSeconds = 0;
+	double selectiveSeconds = 0;
+	for (size_t index = 0; index < positions.size(); index++){
+		const ReversiPosition& position = positions[index];
+		if (position.validMoves() == 0){
+			continue;
+		}
+		fullDepths += fullEngine.searchPosition(position, 64, budgetMs).depth;
+		selectiveDepths +=
+				selectiveEngine.searchPosition(position, 64, budgetMs).depth;
+		timed++;
+
+		// Skip positions solved to the end, they are not cut
+		if (position.getEmptyCount() <= depth){
+			continue;
+		}
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		ReversiEngine::SearchResult full = fullEngine.searchPosition(position,
+				depth, numeric_limits<int>::max() / 2);
+		chrono::steady_clock::time_point middle = chrono::steady_clock::now();
+		ReversiEngine::SearchResult selective =
+				selectiveEngine.searchPosition(position, depth,
+						numeric_limits<int>::max() / 2);
+		chrono::steady_clock::time_point end = chrono::steady_clock::now();
+		fullSeconds += chrono::duration<double>(middle - start).count();
+		selectiveSeconds += chrono::duration<double>(end - middle).count();
+		fullNodes += full.nodes;
+		selectiveNodes += selective.nodes;
+		moveErrors += full.move != selective.move;
+		scoreErrors += abs(full.score - selective.score);
+		compared++;
+		cout << "\rSearched " << compared << " positions" << flush;
+	}
+	cout << endl;
+	if (timed == 0 || compared == 0){
+		cout << "No position to compare" << endl;
+		return true;
+	}
+	cout << fixed << setprecision(2);
+	cout << "Confidence " << confidence * 100 << "% (" <<
+			confidenceToSigmas(confidence) << " sigma), " << timed <<
+			" positions" << endl;
+	cout << "Depth in " << budgetMs << " ms: full-width " <<
+			fullDepths / timed << ", selective " << selectiveDepths / timed <<
+			" (effective depth gain " <<
+			(selectiveDepths - fullDepths) / timed << ")" << endl;
+	cout << "At depth " << depth << " (" << compared << " positions):" <<
+			" best move error rate " << 100.0 * moveErrors / compared <<
+			"%, mean score error " << scoreErrors / compared /
+			ReversiEngine::scoreDisc << " discs" << endl;
+	cout << "Selective search used " << 100 * selectiveNodes / fullNodes <<
+			"% of the nodes and " << 100 * selectiveSeconds / fullSeconds <<
+			"% of the time" << endl;
+	return true;
+}
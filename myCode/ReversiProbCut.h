@@ -0,0 +1,155 @@
+/*
+ * ReversiProbCut.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSIPROBCUT_H_
+#define REVERSIPROBCUT_H_
+
+#include <string>
+
+/**
+ * Parameters of the Multi-ProbCut selective search. The score of a deep
+ * search is predicted from the score of a shallow search of the same
+ * position as deep = a * shallow + b, with a normally distributed error
+ * of standard deviation sigma. If the prediction lies outside the search
+ * window with the confidence asked for, the deep search is skipped.
+ *
+ * Every deep depth has up to checkCount shallow depths that are tried one
+ * after the other, and every game stage has its own parameters as the
+ * evaluation gets more reliable towards the end of the game. The
+ * parameters are fitted by calibrate from full-width searches and kept in
+ * a text file
+ */
+class ReversiProbCut
+{
+public:
+	/**
+	 * Smallest deep depth that is cut, below the shallow search costs as
+	 * much as it saves
+	 */
+	static const int minDepth = 3;
+
+	/**
+	 * Largest deep depth that is cut
+	 */
+	static const int maxDepth = 16;
+
+	/**
+	 * Number of shallow depths per deep depth
+	 */
+	static const int checkCount = 2;
+
+	/**
+	 * Number of game stages, each stage covers 10 numbers of empty fields
+	 */
+	static const int stageCount = 6;
+
+private:
+	/**
+	 * Regression of one pair of depths in one game stage, valid if
+	 * samples is not 0
+	 */
+	struct Parameters{
+		double a;
+		double b;
+		double sigma;
+		int samples;
+	};
+
+	/**
+	 * Parameters by stage, deep depth and check
+	 */
+	Parameters parameters[stageCount][maxDepth + 1][checkCount];
+
+public:
+	/**
+	 * Constructor of class ReversiProbCut without any parameters, nothing
+	 * is cut until parameters are loaded
+	 */
+	ReversiProbCut();
+
+	/**
+	 * Returns the game stage of a position
+	 * \param int empties	: [IN] number of empty fields
+	 * \return stage, 0 to stageCount - 1
+	 */
+	static int getStage(int empties);
+
+	/**
+	 * Returns the depth of a shallow search used to predict a deep search
+	 * \param int depth	: [IN] depth of the deep search
+	 * \param int check	: [IN] number of the check, 0 to checkCount - 1
+	 * \return shallow depth or -1 if the deep depth has no such check
+	 */
+	static int getCheckDepth(int depth, int check);
+
+	/**
+	 * Converts a confidence level to the number of standard deviations a
+	 * prediction has to lie outside the search window
+	 * \param double confidence	: [IN] probability of a correct cut,
+	 * 							between 0.5 and 1
+	 * \return number of standard deviations
+	 */
+	static double confidenceToSigmas(double confidence);
+
+	/**
+	 * Returns the parameters of a check
+	 * \param int empties	: [IN] number of empty fields
+	 * \param int depth		: [IN] depth of the deep search
+	 * \param int check		: [IN] number of the check
+	 * \param double& a		: [OUT] slope of the prediction
+	 * \param double& b		: [OUT] offset of the prediction
+	 * \param double& sigma	: [OUT] standard deviation of the error
+	 * \return false if there are no parameters for the check
+	 */
+	bool getParameters(int empties, int depth, int check, double& a,
+			double& b, double& sigma) const;
+
+	/**
+	 * Reads the parameters from a file written by save
+	 * \param const std::string& path	: [IN] path of the file
+	 * \return false if the file could not be read or is invalid
+	 */
+	bool load(const std::string& path);
+
+	/**
+	 * Writes the parameters to a file
+	 * \param const std::string& path	: [IN] path of the file
+	 * \return false if the file could not be written
+	 */
+	bool save(const std::string& path) const;
+
+	/**
+	 * Fits the parameters: every position is searched full-width to all
+	 * depths up to searchDepth and the scores of each pair of depths are
+	 * put through a linear regression
+	 * \param const std::string& positionPath	: [IN] file of positions
+	 * \param const std::string& dataPath		: [IN] file for the parameters
+	 * \param int searchDepth	: [IN] deepest depth to fit
+	 * \return false if a file could not be read or written
+	 */
+	static bool calibrate(const std::string& positionPath,
+			const std::string& dataPath, int searchDepth);
+
+	/**
+	 * Compares the selective search with the full-width search on a set
+	 * of positions and prints the depth both reach in the same time, and
+	 * how often the selective search finds another move or score at the
+	 * same depth
+	 * \param const std::string& positionPath	: [IN] file of positions
+	 * \param const std::string& dataPath		: [IN] file of the parameters
+	 * \param int depth				: [IN] depth of the comparison
+	 * \param double confidence		: [IN] confidence level of the cuts
+	 * \param int budgetMs			: [IN] time per position for the depth
+	 * 								comparison
+	 * \return false if a file could not be read
+	 */
+	static bool benchmark(const std::string& positionPath,
+			const std::string& dataPath, int depth, double confidence,
+			int budgetMs);
+};
+
+#endif /* REVERSIPROBCUT_H_ */
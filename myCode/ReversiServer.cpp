@@ -0,0 +1,519 @@
+/*
+ * ReversiServer.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include "ReversiServer.h"
+#include "ReversiEngine.h"
+using namespace std;
+
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * Set by the signal handler to leave the event loop
+ */
+static volatile sig_atomic_t serverInterrupted = 0;
+
+/**
+ * Signal handler for SIGINT and SIGTERM
+ * \param int signalNumber	: [IN] number of the signal, not used
+ */
+static void interruptServer(int /*signalNumber*/)
+{
+	serverInterrupted = 1;
+}
+#endif
+
+/**
+ * Constructor of class ReversiServer
+ * The whole game pool is allocated here, so starting a game never
+ * allocates memory
+ * \param const std::string& path	: [IN] path of the socket
+ * \param int workerCount			: [IN] number of worker threads
+ * \param int maxGames				: [IN] size of the game pool
+ */
+ReversiServer::ReversiServer(const string& path, int workerCount,
+		int maxGames): socketPath(path), games(maxGames), nextClientId(1),
+		maxJobs(workerCount * 64), stopping(false), cancelSearches(false),
+		listenFd(-1),
+		epollFd(-1), wakeFd(-1)
+{
+	freeGames.reserve(maxGames);
+	for (int number = maxGames - 1; number >= 0; number--){
+		freeGames.push_back(number);
+	}
+	workers.resize(workerCount);
+}
+
+/**
+ * Returns a started game of a client by number
+ * \param long number		: [IN] number of the game
+ * \param uint64_t clientId	: [IN] id of the client asking
+ * \return pointer to the game or nullptr if there is no such game or it
+ * 			belongs to another client
+ */
+ReversiServer::Game* ReversiServer::findGame(long number, uint64_t clientId)
+{
+	if (number < 0 || number >= (long)games.size() || !games[number].inUse ||
+			games[number].owner != clientId){
+		return nullptr;
+	}
+	return &games[number];
+}
+
+/**
+ * Ends a game and puts its slot back into the pool. The serial number is
+ * increased, so a search still running for the game is not played
+ * \param uint32_t number	: [IN] number of the game
+ */
+void ReversiServer::endGame(uint32_t number)
+{
+	games[number].inUse = 0;
+	games[number].serial++;
+	freeGames.push_back(number);
+}
+
+/**
+ * Plays a move in a game and lets a side without valid moves pass
+ * \param Game& game	: [IN] game to play the move in
+ * \param int index		: [IN] array index of the move
+ * \return true if the move was valid
+ */
+bool ReversiServer::playMove(Game& game, int index)
+{
+	if (game.over || index < 0 || index > 63 ||
+			!(game.validMoves & (1ULL << index))){
+		return false;
+	}
+	game.position = game.position.play(index);
+	game.moves++;
+	game.validMoves = game.position.validMoves();
+	if (!game.validMoves){
+		game.validMoves = game.position.pass().validMoves();
+		if (game.validMoves){
+			game.position = game.position.pass();
+		}
+		else{
+			game.over = 1;
+		}
+	}
+	return true;
+}
+
+/**
+ * Executes one command line
+ * \param Client& client			: [IN] client that sent the command
+ * \param const std::string& line	: [IN] command line
+ * \return answer line without the line end, empty if the answer is
+ * 			sent later by finishJobs
+ */
+string ReversiServer::execute(Client& client, const string& line)
+{
+	istringstream command(line);
+	string name;
+	string extra;
+	long number = -1;
+	command >> name;
+	if (name == "NEW"){
+		if (command >> extra){
+			return "ERR invalid arguments";
+		}
+		if (freeGames.empty()){
+			return "ERR no free game";
+		}
+		uint32_t newNumber = freeGames.back();
+		freeGames.pop_back();
+		Game& game = games[newNumber];
+		game.position = ReversiPosition::initial();
+		game.validMoves = game.position.validMoves();
+		game.owner = client.id;
+		game.serial++;
+		game.moves = 0;
+		game.inUse = 1;
+		game.over = 0;
+		client.games.push_back(newNumber);
+		return "OK " + to_string(newNumber);
+	}
+	if (name != "MOVE" && name != "STATE" && name != "MOVES" &&
+			name != "PLAY" && name != "END"){
+		return "ERR unknown command";
+	}
+
+	// All other commands take the game number and at most two numbers
+	// more, anything else on the line is refused
+	int arguments[2] = {0, 0};
+	int argumentCount = name == "MOVE" ? 2 : name == "PLAY" ? 1 : 0;
+	if (!(command >> number)){
+		return "ERR invalid arguments";
+	}
+	for (int index = 0; index < argumentCount; index++){
+		if (!(command >> arguments[index])){
+			return "ERR invalid arguments";
+		}
+	}
+	if (command >> extra){
+		return "ERR invalid arguments";
+	}
+	Game* game = findGame(number, client.id);
+	if (game == nullptr){
+		return "ERR unknown game";
+	}
+	if (name == "MOVE"){
+		int row = arguments[0];
+		int column = arguments[1];
+		if (row < 1 || row > 8 || column < 1 || column > 8 ||
+				!playMove(*game, (row - 1) * 8 + column - 1)){
+			return "ERR invalid move";
+		}
+		return "OK";
+	}
+	if (name == "STATE"){
+		string answer = "OK " + game->position.toString();
+		if (game->over){
+			answer[answer.size() - 1] = '-';
+		}
+		return answer;
+	}
+	if (name == "MOVES"){
+		string answer = "OK";
+		uint64_t moves = game->validMoves;
+		for (; moves; moves &= moves - 1){
+			int index = __builtin_ctzll(moves);
+			answer += " " + to_string(index / 8 + 1) + " " +
+					to_string(index % 8 + 1);
+		}
+		return answer;
+	}
+	if (name == "PLAY"){
+		int depth = arguments[0];
+		if (game->over){
+			return "ERR game over";
+		}
+		if (depth < 1 || depth > 60){
+			return "ERR invalid depth";
+		}
+		lock_guard<mutex> lock(jobMutex);
+		if (jobs.size() >= maxJobs){
+			return "ERR busy";
+		}
+		Job job = {(uint32_t)number, game->serial, game->moves,
+				game->position, depth,
+				client.fd, client.id, -1};
+		jobs.push_back(job);
+		jobReady.notify_one();
+		return "";
+	}
+	endGame(number);		// END
+	client.games.erase(find(client.games.begin(), client.games.end(),
+			(uint32_t)number));
+	return "OK";
+}
+
+#ifdef __linux__
+
+/**
+ * Loop of a worker thread: takes jobs and searches them. Every worker
+ * has its own engine, so the workers never wait for each other. A
+ * shutdown cancels the running search
+ */
+void ReversiServer::work()
+{
+	ReversiEngine engine(0, 0, 16);
+	engine.setCancelSignal(&cancelSearches);
+	uint64_t one = 1;
+	unique_lock<mutex> lock(jobMutex);
+	while (!stopping){
+		if (jobs.empty()){
+			jobReady.wait(lock);
+			continue;
+		}
+		Job job = jobs.front();
+		jobs.pop_front();
+		lock.unlock();
+		job.move = engine.searchPosition(job.position, job.depth, 60000).move;
+		lock.lock();
+		doneJobs.push_back(job);
+		if (write(wakeFd, &one, sizeof(one)) < 0){
+			cerr << "Could not wake up the event loop" << endl;
+		}
+	}
+}
+
+/**
+ * Accepts all waiting connections
+ */
+void ReversiServer::acceptClients()
+{
+	while (true){
+		int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+		if (fd < 0){
+			return;
+		}
+		epoll_event event;
+		event.events = EPOLLIN;
+		event.data.fd = fd;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+		Client& client = clients.emplace(fd, Client()).first->second;
+		client.fd = fd;
+		client.id = nextClientId++;
+		client.input.clear();
+		client.output.clear();
+	}
+}
+
+/**
+ * Reads from a client and answers all complete commands
+ * \param int fd	: [IN] file descriptor of the client
+ */
+void ReversiServer::readClient(int fd)
+{
+	unordered_map<int, Client>::iterator found = clients.find(fd);
+	if (found == clients.end()){
+		return;
+	}
+	Client& client = found->second;
+	char buffer[4096];
+	while (true){
+		ssize_t length = read(fd, buffer, sizeof(buffer));
+		if (length > 0){
+			client.input.append(buffer, length);
+			continue;
+		}
+		if (length == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)){
+			closeClient(fd);
+			return;
+		}
+		break;
+	}
+	size_t start = 0;
+	size_t end;
+	while ((end = client.input.find('\n', start)) != string::npos){
+		string answer = execute(client,
+				client.input.substr(start, end - start));
+		if (!answer.empty()){
+			client.output += answer + "\n";
+		}
+		start = end + 1;
+	}
+	client.input.erase(0, start);
+	flushClient(client);
+}
+
+/**
+ * Sends as much of the output of a client as the socket takes and
+ * watches the socket for writing if something is left
+ * \param Client& client	: [IN] client to send to
+ */
+void ReversiServer::flushClient(Client& client)
+{
+	bool pending = !client.output.empty();
+	while (!client.output.empty()){
+		ssize_t length = send(client.fd, client.output.data(),
+				client.output.size(), MSG_NOSIGNAL);
+		if (length <= 0){
+			break;
+		}
+		client.output.erase(0, length);
+	}
+	if (pending){
+		epoll_event event;
+		event.events = client.output.empty() ? EPOLLIN : EPOLLIN | EPOLLOUT;
+		event.data.fd = client.fd;
+		epoll_ctl(epollFd, EPOLL_CTL_MOD, client.fd, &event);
+	}
+}
+
+/**
+ * Closes the connection of a client and ends all games it has not ended
+ * \param int fd	: [IN] file descriptor of the client
+ */
+void ReversiServer::closeClient(int fd)
+{
+	epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+	close(fd);
+	unordered_map<int, Client>::iterator client = clients.find(fd);
+	if (client != clients.end()){
+		for (size_t index = 0; index < client->second.games.size(); index++){
+			endGame(client->second.games[index]);
+		}
+		clients.erase(client);
+	}
+}
+
+/**
+ * Answers the searched jobs and plays their moves. A move is only played
+ * if the game has not ended, been started again or changed since the job
+ * was queued
+ */
+void ReversiServer::finishJobs()
+{
+	uint64_t count;
+	if (read(wakeFd, &count, sizeof(count)) < 0){
+		return;
+	}
+	deque<Job> finished;
+	{
+		lock_guard<mutex> lock(jobMutex);
+		finished.swap(doneJobs);
+	}
+	for (size_t index = 0; index < finished.size(); index++){
+		const Job& job = finished[index];
+		unordered_map<int, Client>::iterator client = clients.find(job.fd);
+		if (client == clients.end() || client->second.id != job.clientId){
+			continue;
+		}
+		Game* game = findGame(job.game, job.clientId);
+		if (game == nullptr || game->serial != job.serial ||
+				game->moves != job.moves){
+			client->second.output += "ERR game changed\n";
+		}
+		else if (!playMove(*game, job.move)){
+			client->second.output += "ERR game over\n";
+		}
+		else{
+			client->second.output += "OK " + to_string(job.move / 8 + 1) +
+					" " + to_string(job.move % 8 + 1) + "\n";
+		}
+		flushClient(client->second);
+	}
+}
+
+/**
+ * Opens the socket and runs the event loop until SIGINT or SIGTERM
+ * \return false if the socket could not be opened, else true
+ */
+bool ReversiServer::run()
+{
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path)){
+		cerr << "Socket path too long: " << socketPath << endl;
+		return false;
+	}
+	strcpy(address.sun_path, socketPath.c_str());
+	unlink(socketPath.c_str());
+	listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+	if (listenFd < 0 || bind(listenFd, (sockaddr*)&address,
+			sizeof(address)) < 0 || listen(listenFd, SOMAXCONN) < 0){
+		cerr << "Could not open socket " << socketPath << ": " <<
+				strerror(errno) << endl;
+		return false;
+	}
+	epollFd = epoll_create1(0);
+	wakeFd = eventfd(0, EFD_NONBLOCK);
+	epoll_event event;
+	event.events = EPOLLIN;
+	event.data.fd = listenFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+	event.data.fd = wakeFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+	for (size_t index = 0; index < workers.size(); index++){
+		workers[index] = thread(&ReversiServer::work, this);
+	}
+	signal(SIGINT, interruptServer);
+	signal(SIGTERM, interruptServer);
+	cout << "Server listening on " << socketPath << " with " <<
+			workers.size() << " workers and " << games.size() <<
+			" games" << endl;
+
+	epoll_event events[256];
+	while (!serverInterrupted){
+		int count = epoll_wait(epollFd, events, 256, -1);
+		for (int index = 0; index < count; index++){
+			int fd = events[index].data.fd;
+			if (fd == listenFd){
+				acceptClients();
+			}
+			else if (fd == wakeFd){
+				finishJobs();
+			}
+			else if (events[index].events & (EPOLLIN | EPOLLHUP | EPOLLERR)){
+				readClient(fd);
+			}
+			else{
+				unordered_map<int, Client>::iterator client = clients.find(fd);
+				if (client != clients.end()){
+					flushClient(client->second);
+				}
+			}
+		}
+	}
+	cout << "Server stopped" << endl;
+	return true;
+}
+
+/**
+ * Destructor of class ReversiServer, stops the workers and closes all
+ * connections
+ */
+ReversiServer::~ReversiServer()
+{
+	{
+		lock_guard<mutex> lock(jobMutex);
+		stopping = true;
+	}
+	cancelSearches.store(true);
+	jobReady.notify_all();
+	for (size_t index = 0; index < workers.size(); index++){
+		if (workers[index].joinable()){
+			workers[index].join();
+		}
+	}
+	while (!clients.empty()){
+		closeClient(clients.begin()->first);
+	}
+	if (wakeFd >= 0){
+		close(wakeFd);
+	}
+	if (epollFd >= 0){
+		close(epollFd);
+	}
+	if (listenFd >= 0){
+		close(listenFd);
+		unlink(socketPath.c_str());
+	}
+}
+
+#else
+
+/**
+ * Loop of a worker thread, not used without epoll
+ */
+void ReversiServer::work()
+{
+}
+
+/**
+ * The server needs epoll and Unix domain sockets, which only Linux offers
+ * \return false
+ */
+bool ReversiServer::run()
+{
+	cerr << "The server is only available on Linux" << endl;
+	return false;
+}
+
+/**
+ * Destructor of class ReversiServer
+ */
+ReversiServer::~ReversiServer()
+{
+}
+
+#endif
@@ -0,0 +1,248 @@
+/*
+ * ReversiServer.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSISERVER_H_
+#define REVERSISERVER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ReversiPosition.h"
+
+/**
+ * Server holding many games in one process. Clients connect over a Unix
+ * domain socket and send one command per line, every command is answered
+ * with one line starting with OK or ERR:
+ *
+ *   NEW                    -> OK <game>
+ *   MOVE <game> <row> <col>-> OK
+ *   STATE <game>           -> OK <64 fields of X, O or .> <X, O or - if over>
+ *   MOVES <game>           -> OK <row> <col> <row> <col> ...
+ *   PLAY <game> <depth>    -> OK <row> <col>, the computer moves
+ *   END <game>             -> OK
+ *
+ * A game can only be used by the connection that started it, its games
+ * are ended when the connection is closed. A side without a valid move
+ * passes automatically. PLAY is searched by a fixed number of worker
+ * threads, all other commands are answered by the event loop directly
+ */
+class ReversiServer
+{
+	/**
+	 * State of one game. All games are kept in one array, so a game is
+	 * found by its number without any pointer chasing. The valid moves of
+	 * the side to move are computed once per move, so checking a move and
+	 * listing the moves are lookups
+	 */
+	struct Game{
+		ReversiPosition position;	// discs and player to move
+		uint64_t validMoves;	// valid moves of position, 0 if over
+		uint64_t owner;			// id of the client that started the game
+		uint32_t serial;		// increased whenever the slot is reused
+		uint32_t moves;			// number of moves played
+		uint8_t inUse;			// 1 if the game has been started
+		uint8_t over;			// 1 if no side can move any more
+	};
+
+	/**
+	 * Connection of a client with its unprocessed input and unsent output
+	 * and the numbers of the games it has started and not ended
+	 */
+	struct Client{
+		int fd;
+		uint64_t id;
+		std::string input;
+		std::string output;
+		std::vector<uint32_t> games;
+	};
+
+	/**
+	 * Search request for the worker threads. The game's serial number and
+	 * move count are kept to detect if the game has ended, was started
+	 * again or has changed while the job was searched
+	 */
+	struct Job{
+		uint32_t game;
+		uint32_t serial;
+		uint32_t moves;
+		ReversiPosition position;
+		int depth;
+		int fd;
+		uint64_t clientId;
+		int move;
+	};
+
+	/**
+	 * Path of the Unix domain socket
+	 */
+	std::string socketPath;
+
+	/**
+	 * Pool of all games
+	 */
+	std::vector<Game> games;
+
+	/**
+	 * Numbers of the unused games in the pool
+	 */
+	std::vector<uint32_t> freeGames;
+
+	/**
+	 * Connected clients by file descriptor
+	 */
+	std::unordered_map<int, Client> clients;
+
+	/**
+	 * Id given to the next client, to tell a new client from an old one
+	 * that had the same file descriptor
+	 */
+	uint64_t nextClientId;
+
+	/**
+	 * Worker threads searching the PLAY jobs
+	 */
+	std::vector<std::thread> workers;
+
+	/**
+	 * Jobs waiting for a worker
+	 */
+	std::deque<Job> jobs;
+
+	/**
+	 * Jobs searched by a worker, waiting for the event loop
+	 */
+	std::deque<Job> doneJobs;
+
+	/**
+	 * Maximum number of waiting jobs, further PLAY commands are refused
+	 */
+	size_t maxJobs;
+
+	/**
+	 * Guards jobs, doneJobs and stopping
+	 */
+	std::mutex jobMutex;
+
+	/**
+	 * Signals the workers that a job is waiting or the server stops
+	 */
+	std::condition_variable jobReady;
+
+	/**
+	 * Set to stop the workers
+	 */
+	bool stopping;
+
+	/**
+	 * Set on shutdown to cancel the searches the workers are running
+	 */
+	std::atomic<bool> cancelSearches;
+
+	/**
+	 * File descriptors of the listening socket, the epoll instance and the
+	 * event used by the workers to wake up the event loop
+	 */
+	int listenFd;
+	int epollFd;
+	int wakeFd;
+
+	/**
+	 * Loop of a worker thread: takes jobs and searches them
+	 */
+	void work();
+
+	/**
+	 * Accepts all waiting connections
+	 */
+	void acceptClients();
+
+	/**
+	 * Reads from a client and answers all complete commands
+	 * \param int fd	: [IN] file descriptor of the client
+	 */
+	void readClient(int fd);
+
+	/**
+	 * Sends as much of the output of a client as the socket takes and
+	 * watches the socket for writing if something is left
+	 * \param Client& client	: [IN] client to send to
+	 */
+	void flushClient(Client& client);
+
+	/**
+	 * Closes the connection of a client
+	 * \param int fd	: [IN] file descriptor of the client
+	 */
+	void closeClient(int fd);
+
+	/**
+	 * Answers the searched jobs and plays their moves
+	 */
+	void finishJobs();
+
+	/**
+	 * Executes one command line
+	 * \param Client& client			: [IN] client that sent the command
+	 * \param const std::string& line	: [IN] command line
+	 * \return answer line without the line end, empty if the answer is
+	 * 			sent later by finishJobs
+	 */
+	std::string execute(Client& client, const std::string& line);
+
+	/**
+	 * Returns a started game of a client by number
+	 * \param long number		: [IN] number of the game
+	 * \param uint64_t clientId	: [IN] id of the client asking
+	 * \return pointer to the game or nullptr if there is no such game or
+	 * 			it belongs to another client
+	 */
+	Game* findGame(long number, uint64_t clientId);
+
+	/**
+	 * Ends a game and puts its slot back into the pool. The serial number
+	 * is increased, so a search still running for the game is not played
+	 * \param uint32_t number	: [IN] number of the game
+	 */
+	void endGame(uint32_t number);
+
+	/**
+	 * Plays a move in a game and lets a side without valid moves pass
+	 * \param Game& game	: [IN] game to play the move in
+	 * \param int index		: [IN] array index of the move
+	 * \return true if the move was valid
+	 */
+	static bool playMove(Game& game, int index);
+
+public:
+	/**
+	 * Constructor of class ReversiServer
+	 * \param const std::string& path	: [IN] path of the socket
+	 * \param int workerCount			: [IN] number of worker threads
+	 * \param int maxGames				: [IN] size of the game pool
+	 */
+	ReversiServer(const std::string& path, int workerCount, int maxGames);
+
+	/**
+	 * Opens the socket and runs the event loop until SIGINT or SIGTERM
+	 * \return false if the socket could not be opened, else true
+	 */
+	bool run();
+
+	/**
+	 * Destructor of class ReversiServer, stops the workers and closes all
+	 * connections
+	 */
+	virtual ~ReversiServer();
+};
+
+#endif /* REVERSISERVER_H_ */
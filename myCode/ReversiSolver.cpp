@@ -0,0 +1,338 @@
+/*
+ * ReversiSolver.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include "ReversiPositionFile.h"
+#include "ReversiSolver.h"
+using namespace std;
+
+/**
+ * Score larger than any final disc difference, used as window limit
+ */
+static const int solveInfinity = 65;
+
+/**
+ * Sorts moves by the number of replies they leave the opponent, fewest
+ * first, with a given move in front. Positions with few replies have
+ * small subtrees and usually good scores
+ * \param const ReversiPosition& position	: [IN] position to move in
+ * \param uint64_t moves	: [IN] valid moves of the position
+ * \param int firstMove		: [IN] move to put first or -1
+ * \param int* moveList		: [OUT] sorted array indices of the moves
+ * \return number of moves
+ */
+static int orderMoves(const ReversiPosition& position, uint64_t moves,
+		int firstMove, int* moveList)
+{
+	int orderKeys[32];
+	int moveCount = 0;
+	for (; moves; moves &= moves - 1){
+		int index = __builtin_ctzll(moves);
+		int orderKey = index == firstMove ? -1 :
+				__builtin_popcountll(position.play(index).validMoves());
+		int slot = moveCount++;
+		while (slot > 0 && orderKeys[slot - 1] > orderKey){
+			moveList[slot] = moveList[slot - 1];
+			orderKeys[slot] = orderKeys[slot - 1];
+			slot--;
+		}
+		moveList[slot] = index;
+		orderKeys[slot] = orderKey;
+	}
+	return moveCount;
+}
+
+/**
+ * Constructor of class ReversiSolver
+ * \param ReversiThreadPool& pool	: [IN] pool for the root moves
+ * \param int hashSizeMb			: [IN] size of the hash table in
+ * 									megabytes
+ */
+ReversiSolver::ReversiSolver(ReversiThreadPool& pool, int hashSizeMb):
+		pool(pool), hashTable(hashSizeMb)
+{
+}
+
+/**
+ * Principal variation search to the end of the game in negamax form: the
+ * first move is searched with the whole window, the others only have to
+ * be shown to be worse. The number of empty fields is stored as depth in
+ * the hash table, as every search goes to the end. Two passes in a row
+ * end the game
+ * \param const ReversiPosition& position	: [IN] position to search
+ * \param int alpha		: [IN] lower limit of the search window
+ * \param int beta		: [IN] upper limit of the search window
+ * \param bool passed	: [IN] true if the last move was a pass
+ * \param uint64_t& nodes	: [IN,OUT] counter of searched nodes
+ * \return final disc difference for the side to move
+ */
+int ReversiSolver::search(const ReversiPosition& position, int alpha,
+		int beta, bool passed, uint64_t& nodes)
+{
+	nodes++;
+	uint64_t moves = position.validMoves();
+	if (moves == 0){
+		if (passed){
+			return position.getDiscDifference();
+		}
+		return -search(position.pass(), -beta, -alpha, true, nodes);
+	}
+	int empties = position.getEmptyCount();
+
+	uint64_t key = 0;
+	int hashMove = -1;
+	if (empties >= hashEmpties){
+		key = position.hash();
+		int hashDepth;
+		int hashScore;
+		ReversiHashTable::BOUND_t hashBound;
+		int move;
+		if (hashTable.probe(key, hashDepth, hashScore, hashBound, move)){
+			if (hashBound == ReversiHashTable::BOUND_EXACT ||
+					(hashBound == ReversiHashTable::BOUND_LOWER &&
+							hashScore >= beta) ||
+					(hashBound == ReversiHashTable::BOUND_UPPER &&
+							hashScore <= alpha)){
+				return hashScore;
+			}
+			hashMove = move == ReversiHashTable::noMove ? -1 : move;
+		}
+	}
+
+	int moveList[32];
+	int moveCount = 0;
+	if (empties >= orderEmpties){
+		moveCount = orderMoves(position, moves, hashMove, moveList);
+	}
+	else{
+		for (; moves; moves &= moves - 1){
+			moveList[moveCount++] = __builtin_ctzll(moves);
+		}
+	}
+
+	int originalAlpha = alpha;
+	int bestScore = -solveInfinity;
+	int bestMove = ReversiHashTable::noMove;
+	for (int moveIndex = 0; moveIndex < moveCount; moveIndex++){
+		int index = moveList[moveIndex];
+		ReversiPosition next = position.play(index);
+		int score;
+		if (moveIndex == 0){
+			score = -search(next, -beta, -alpha, false, nodes);
+		}
+		else{
+			// Prove with a null window that the move is not better than the
+			// best one so far, search it again only if that fails
+			score = -search(next, -alpha - 1, -alpha, false, nodes);
+			if (score > alpha && score < beta){
+				score = -search(next, -beta, -score, false, nodes);
+			}
+		}
+		if (score > bestScore){
+			bestScore = score;
+			bestMove = index;
+			if (score > alpha){
+				alpha = score;
+				if (alpha >= beta){
+					break;
+				}
+			}
+		}
+	}
+
+	if (empties >= hashEmpties){
+		ReversiHashTable::BOUND_t bound = ReversiHashTable::BOUND_EXACT;
+		if (bestScore <= originalAlpha){
+			bound = ReversiHashTable::BOUND_UPPER;
+		}
+		else if (bestScore >= beta){
+			bound = ReversiHashTable::BOUND_LOWER;
+		}
+		hashTable.store(key, empties, bestScore, bound, bestMove);
+	}
+	return bestScore;
+}
+
+/**
+ * Solves a position. The first move is searched with the full window.
+ * With splitEmpties or more empty fields the other moves are then
+ * searched as separate tasks of the pool, each tested with a null window
+ * against the best score known when it starts, else they are searched
+ * one after the other the same way. May be called by several threads at
+ * once, also from tasks of the pool
+ * \param const ReversiPosition& position	: [IN] position to solve
+ * \return result of the search
+ */
+ReversiSolver::Result ReversiSolver::solve(const ReversiPosition& position)
+{
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	Result result{0, -1, 0, 0};
+	uint64_t moves = position.validMoves();
+	if (moves == 0){
+		result.score = search(position, -solveInfinity, solveInfinity, false,
+				result.nodes);
+	}
+	else{
+		int moveList[32];
+		int moveCount = orderMoves(position, moves, -1, moveList);
+		result.nodes = 1;
+		result.move = moveList[0];
+		result.score = -search(position.play(moveList[0]), -solveInfinity,
+				solveInfinity, false, result.nodes);
+		if (position.getEmptyCount() >= splitEmpties && moveCount > 1){
+			mutex bestMutex;
+			atomic<uint64_t> splitNodes(0);
+			atomic<int> pending(moveCount - 1);
+			for (int moveIndex = 1; moveIndex < moveCount; moveIndex++){
+				int index = moveList[moveIndex];
+				pool.submit([this, &position, &result, &bestMutex,
+						&splitNodes, &pending, index]{
+					int alpha;
+					{
+						lock_guard<mutex> lock(bestMutex);
+						alpha = result.score;
+					}
+					uint64_t nodes = 0;
+					ReversiPosition next = position.play(index);
+					int score = -search(next, -alpha - 1, -alpha, false, nodes);
+					if (score > alpha){
+						score = -search(next, -solveInfinity, -score, false,
+								nodes);
+					}
+					{
+						lock_guard<mutex> lock(bestMutex);
+						if (score > result.score){
+							result.score = score;
+							result.move = index;
+						}
+					}
+					splitNodes += nodes;
+					pending--;
+				});
+			}
+			pool.waitFor(pending);
+			result.nodes += splitNodes.load();
+		}
+		else{
+			for (int moveIndex = 1; moveIndex < moveCount; moveIndex++){
+				int index = moveList[moveIndex];
+				ReversiPosition next = position.play(index);
+				int score = -search(next, -result.score - 1, -result.score,
+						false, result.nodes);
+				if (score > result.score){
+					score = -search(next, -solveInfinity, -score, false,
+							result.nodes);
+				}
+				if (score > result.score){
+					result.score = score;
+					result.move = index;
+				}
+			}
+		}
+	}
+	result.seconds = chrono::duration<double>(
+			chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+/**
+ * Solves all positions of a file and writes one line per position in
+ * the order of the file: position, score, best move, nodes and
+ * milliseconds. Every position is one task of the pool, the calling
+ * thread writes the results as soon as the position and all positions
+ * before it are solved. Prints positions per hour and the node counts
+ * at the end
+ * \param const std::string& inputPath	: [IN] file of positions
+ * \param const std::string& outputPath	: [IN] file for the results, -
+ * 										for the console
+ * \param int threadCount	: [IN] number of threads
+ * \param int hashSizeMb	: [IN] size of the hash table in megabytes
+ * \return false if a file could not be read or written
+ */
+bool ReversiSolver::solveFile(const string& inputPath,
+		const string& outputPath, int threadCount, int hashSizeMb)
+{
+	vector<ReversiPosition> positions;
+	if (!ReversiPositionFile::read(inputPath, positions)){
+		return false;
+	}
+	ofstream file;
+	if (outputPath != "-"){
+		file.open(outputPath.c_str());
+		if (!file){
+			cout << "Cannot write " << outputPath << endl;
+			return false;
+		}
+	}
+	ostream& output = outputPath != "-" ? file : cout;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	vector<Result> results(positions.size());
+	vector<char> solved(positions.size(), 0);
+	mutex solvedMutex;
+	condition_variable solvedReady;
+	uint64_t totalNodes = 0;
+	uint64_t minNodes = 0;
+	uint64_t maxNodes = 0;
+	{
+		ReversiThreadPool pool(threadCount);
+		ReversiSolver solver(pool, hashSizeMb);
+		for (size_t index = 0; index < positions.size(); index++){
+			pool.submit([&, index]{
+				Result result = solver.solve(positions[index]);
+				lock_guard<mutex> lock(solvedMutex);
+				results[index] = result;
+				solved[index] = 1;
+				solvedReady.notify_all();
+			});
+		}
+
+		for (size_t index = 0; index < positions.size(); index++){
+			{
+				unique_lock<mutex> lock(solvedMutex);
+				solvedReady.wait(lock, [&]{ return solved[index] != 0; });
+			}
+			const Result& result = results[index];
+			output << positions[index].toString() << ' ' << result.score <<
+					' ' << ReversiPosition::moveToString(result.move) << ' ' <<
+					result.nodes << ' ' << (long)(result.seconds * 1000) <<
+					endl;
+			totalNodes += result.nodes;
+			minNodes = index == 0 || result.nodes < minNodes ? result.nodes :
+					minNodes;
+			maxNodes = result.nodes > maxNodes ? result.nodes : maxNodes;
+		}
+	}
+	double seconds = chrono::duration<double>(
+			chrono::steady_clock::now() - start).count();
+	if (outputPath != "-"){
+		file.close();
+		if (!file){
+			cout << "Cannot write " << outputPath << endl;
+			return false;
+		}
+	}
+
+	cout << fixed << setprecision(1);
+	cout << "Solved " << positions.size() << " positions with " <<
+			threadCount << " threads in " << seconds << " s" << endl;
+	if (!positions.empty()){
+		cout << "Positions/hour: " << (long)(positions.size() * 3600.0 /
+				seconds) << endl;
+		cout << "Nodes: total " << totalNodes << ", per position min " <<
+				minNodes << ", mean " << totalNodes / positions.size() <<
+				", max " << maxNodes << ", " << (long)(totalNodes / seconds) <<
+				" nodes/s" << endl;
+	}
+	return true;
+}
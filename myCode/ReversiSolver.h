@@ -0,0 +1,113 @@
+/*
+ * ReversiSolver.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSISOLVER_H_
+#define REVERSISOLVER_H_
+
+#include <cstdint>
+#include <string>
+#include "ReversiHashTable.h"
+#include "ReversiPosition.h"
+#include "ReversiThreadPool.h"
+
+/**
+ * Exact endgame solver: searches positions to the end of the game and
+ * returns the final disc difference with best play of both sides. The
+ * hash table is shared by all threads, positions with many empty fields
+ * are split at the root and their moves are searched in parallel on a
+ * thread pool
+ */
+class ReversiSolver
+{
+public:
+	/**
+	 * Result of solving a position: final disc difference for the side to
+	 * move, best move as array index (-1 for a pass or if the game is
+	 * over), searched nodes and the time taken
+	 */
+	struct Result{
+		int score;
+		int move;
+		uint64_t nodes;
+		double seconds;
+	};
+
+	/**
+	 * Fewest empty fields for which the root is split over the pool
+	 */
+	static const int splitEmpties = 16;
+
+private:
+	/**
+	 * Fewest empty fields for which the hash table is used, closer to the
+	 * end searching is cheaper than the memory access
+	 */
+	static const int hashEmpties = 9;
+
+	/**
+	 * Fewest empty fields for which the moves are sorted by the mobility
+	 * of the opponent
+	 */
+	static const int orderEmpties = 7;
+
+	/**
+	 * Pool searching the root moves of split positions
+	 */
+	ReversiThreadPool& pool;
+
+	/**
+	 * Positions already solved, shared between all threads
+	 */
+	ReversiHashTable hashTable;
+
+	/**
+	 * Alpha-beta search to the end of the game in negamax form
+	 * \param const ReversiPosition& position	: [IN] position to search
+	 * \param int alpha		: [IN] lower limit of the search window
+	 * \param int beta		: [IN] upper limit of the search window
+	 * \param bool passed	: [IN] true if the last move was a pass
+	 * \param uint64_t& nodes	: [IN,OUT] counter of searched nodes
+	 * \return final disc difference for the side to move
+	 */
+	int search(const ReversiPosition& position, int alpha, int beta,
+			bool passed, uint64_t& nodes);
+
+public:
+	/**
+	 * Constructor of class ReversiSolver
+	 * \param ReversiThreadPool& pool	: [IN] pool for the root moves
+	 * \param int hashSizeMb			: [IN] size of the hash table in
+	 * 									megabytes
+	 */
+	ReversiSolver(ReversiThreadPool& pool, int hashSizeMb);
+
+	/**
+	 * Solves a position. May be called by several threads at once, also
+	 * from tasks of the pool
+	 * \param const ReversiPosition& position	: [IN] position to solve
+	 * \return result of the search
+	 */
+	Result solve(const ReversiPosition& position);
+
+	/**
+	 * Solves all positions of a file and writes one line per position in
+	 * the order of the file: position, score, best move, nodes and
+	 * milliseconds. Lines are written as soon as the position and all
+	 * positions before it are solved. Prints positions per hour and the
+	 * node counts at the end
+	 * \param const std::string& inputPath	: [IN] file of positions
+	 * \param const std::string& outputPath	: [IN] file for the results, -
+	 * 										for the console
+	 * \param int threadCount	: [IN] number of threads
+	 * \param int hashSizeMb	: [IN] size of the hash table in megabytes
+	 * \return false if a file could not be read or written
+	 */
+	static bool solveFile(const std::string& inputPath,
+			const std::string& outputPath, int threadCount, int hashSizeMb);
+};
+
+#endif /* REVERSISOLVER_H_ */
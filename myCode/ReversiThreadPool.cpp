@@ -0,0 +1,168 @@
+/*
+ * ReversiThreadPool.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include "ReversiThreadPool.h"
+using namespace std;
+
+/**
+ * Pool and number of the worker running on the current thread, nullptr
+ * and -1 for threads outside any pool
+ */
+static thread_local ReversiThreadPool* currentPool = nullptr;
+static thread_local int currentWorker = -1;
+
+/**
+ * Constructor of class ReversiThreadPool, starts the workers
+ * \param int threadCount	: [IN] number of worker threads
+ */
+ReversiThreadPool::ReversiThreadPool(int threadCount):
+		queuedTasks(0), stopping(false)
+{
+	if (threadCount < 1){
+		threadCount = 1;
+	}
+	for (int index = 0; index < threadCount; index++){
+		workerQueues.push_back(unique_ptr<WorkerQueue>(new WorkerQueue()));
+	}
+	for (int index = 0; index < threadCount; index++){
+		threads.push_back(thread(&ReversiThreadPool::work, this, index));
+	}
+}
+
+/**
+ * Loop of a worker thread: runs tasks while there are any and sleeps
+ * until the next submit otherwise. Returns when the pool stops and all
+ * tasks are done
+ * \param int index	: [IN] number of the worker
+ */
+void ReversiThreadPool::work(int index)
+{
+	currentPool = this;
+	currentWorker = index;
+	while (true){
+		if (runTask(true)){
+			continue;
+		}
+		unique_lock<mutex> lock(sharedMutex);
+		taskReady.wait(lock, [this]{
+			return stopping || queuedTasks.load() > 0;
+		});
+		if (stopping && queuedTasks.load() == 0){
+			return;
+		}
+	}
+}
+
+/**
+ * Takes one task and runs it: the newest task of the own queue, else
+ * the oldest shared task, else the oldest task of another worker
+ * \param bool shared	: [IN] true to take tasks from the shared queue
+ * \return false if no task was found
+ */
+bool ReversiThreadPool::runTask(bool shared)
+{
+	function<void()> task;
+	int self = currentPool == this ? currentWorker : -1;
+	if (self >= 0){
+		WorkerQueue& queue = *workerQueues[self];
+		lock_guard<mutex> lock(queue.mutex);
+		if (!queue.tasks.empty()){
+			task = move(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+	}
+	if (!task && shared){
+		lock_guard<mutex> lock(sharedMutex);
+		if (!sharedTasks.empty()){
+			task = move(sharedTasks.front());
+			sharedTasks.pop_front();
+		}
+	}
+	int count = (int)workerQueues.size();
+	for (int offset = 1; !task && offset <= count; offset++){
+		WorkerQueue& queue = *workerQueues[(self + offset + count) % count];
+		lock_guard<mutex> lock(queue.mutex);
+		if (!queue.tasks.empty()){
+			task = move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+	}
+	if (!task){
+		return false;
+	}
+	queuedTasks--;
+	task();
+	return true;
+}
+
+/**
+ * Returns the number of worker threads
+ * \return number of worker threads
+ */
+int ReversiThreadPool::getThreadCount() const
+{
+	return (int)threads.size();
+}
+
+/**
+ * Queues a task, on the queue of the current worker if called by a task,
+ * else on the shared queue. Tasks may submit further tasks
+ * \param std::function<void()> task	: [IN] task to run
+ */
+void ReversiThreadPool::submit(function<void()> task)
+{
+	if (currentPool == this){
+		WorkerQueue& queue = *workerQueues[currentWorker];
+		lock_guard<mutex> lock(queue.mutex);
+		queue.tasks.push_back(move(task));
+		queuedTasks++;
+	}
+	else{
+		lock_guard<mutex> lock(sharedMutex);
+		sharedTasks.push_back(move(task));
+		queuedTasks++;
+	}
+	// Taking the lock makes sure a worker that is about to sleep either
+	// sees the new task or gets the notification
+	{
+		lock_guard<mutex> lock(sharedMutex);
+	}
+	taskReady.notify_one();
+}
+
+/**
+ * Waits until a counter of unfinished tasks drops to 0. The waiting
+ * thread runs tasks of its own queue or steals tasks meanwhile, so a
+ * task may wait for its subtasks without blocking a worker. Shared tasks
+ * are not started, a new job would delay the end of the waiting one
+ * \param const std::atomic<int>& pending	: [IN] unfinished tasks,
+ * 									counted down by the tasks
+ */
+void ReversiThreadPool::waitFor(const atomic<int>& pending)
+{
+	while (pending.load() > 0){
+		if (!runTask(false)){
+			this_thread::yield();
+		}
+	}
+}
+
+/**
+ * Destructor of class ReversiThreadPool, runs the queued tasks and
+ * stops the workers
+ */
+ReversiThreadPool::~ReversiThreadPool()
+{
+	{
+		lock_guard<mutex> lock(sharedMutex);
+		stopping = true;
+	}
+	taskReady.notify_all();
+	for (size_t index = 0; index < threads.size(); index++){
+		threads[index].join();
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ * ReversiThreadPool.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSITHREADPOOL_H_
+#define REVERSITHREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Pool of worker threads with work stealing. Every worker has its own
+ * queue: tasks submitted by a task go to the queue of its worker and are
+ * taken newest first, so a worker stays on the subtree it is working on.
+ * Tasks submitted from outside the pool go to a shared queue and are
+ * started oldest first. A worker without tasks steals the oldest task of
+ * another worker, which usually is the largest piece of work left
+ */
+class ReversiThreadPool
+{
+	/**
+	 * Queue of a worker, the owner takes from the back, thieves from the
+	 * front
+	 */
+	struct WorkerQueue{
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	/**
+	 * Queues of the workers
+	 */
+	std::vector<std::unique_ptr<WorkerQueue>> workerQueues;
+
+	/**
+	 * Tasks submitted from outside the pool
+	 */
+	std::deque<std::function<void()>> sharedTasks;
+
+	/**
+	 * Guards sharedTasks and stopping, used by idle workers to wait
+	 */
+	std::mutex sharedMutex;
+
+	/**
+	 * Signals idle workers that a task was submitted or the pool stops
+	 */
+	std::condition_variable taskReady;
+
+	/**
+	 * Number of tasks in all queues
+	 */
+	std::atomic<int> queuedTasks;
+
+	/**
+	 * Set to stop the workers once all tasks are done
+	 */
+	bool stopping;
+
+	/**
+	 * Worker threads
+	 */
+	std::vector<std::thread> threads;
+
+	/**
+	 * Loop of a worker thread
+	 * \param int index	: [IN] number of the worker
+	 */
+	void work(int index);
+
+	/**
+	 * Takes one task and runs it
+	 * \param bool shared	: [IN] true to take tasks from the shared queue
+	 * \return false if no task was found
+	 */
+	bool runTask(bool shared);
+
+public:
+	/**
+	 * Constructor of class ReversiThreadPool, starts the workers
+	 * \param int threadCount	: [IN] number of worker threads
+	 */
+	ReversiThreadPool(int threadCount);
+
+	/**
+	 * Returns the number of worker threads
+	 * \return number of worker threads
+	 */
+	int getThreadCount() const;
+
+	/**
+	 * Queues a task. Tasks may submit further tasks
+	 * \param std::function<void()> task	: [IN] task to run
+	 */
+	void submit(std::function<void()> task);
+
+	/**
+	 * Waits until a counter of unfinished tasks drops to 0. The waiting
+	 * thread runs tasks of its own queue or steals tasks meanwhile, so a
+	 * task may wait for its subtasks without blocking a worker
+	 * \param const std::atomic<int>& pending	: [IN] unfinished tasks,
+	 * 									counted down by the tasks
+	 */
+	void waitFor(const std::atomic<int>& pending);
+
+	/**
+	 * Destructor of class ReversiThreadPool, runs the queued tasks and
+	 * stops the workers
+	 */
+	virtual ~ReversiThreadPool();
+};
+
+#endif /* REVERSITHREADPOOL_H_ */
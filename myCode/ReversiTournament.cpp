@@ -0,0 +1,481 @@
+/*
+ * ReversiTournament.cpp
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+#include "ReversiEngine.h"
+#include "ReversiGameFile.h"
+#include "ReversiThreadPool.h"
+#include "ReversiTournament.h"
+using namespace std;
+
+/**
+ * Depth of the search that checks if an opening is balanced
+ */
+static const int openingDepth = 4;
+
+/**
+ * Largest score of a balanced opening in 1/100 discs
+ */
+static const int openingMaxScore = 2 * ReversiEngine::scoreDisc;
+
+/**
+ * Error probabilities of the SPRT: alpha of accepting H1 when H0 holds
+ * and beta of accepting H0 when H1 holds
+ */
+static const double sprtAlpha = 0.05;
+static const double sprtBeta = 0.05;
+
+/**
+ * Converts an expected score per game to an Elo difference
+ * \param double score	: [IN] expected score between 0 and 1
+ * \return Elo difference, limited to +-2000 for scores of 0 and 1
+ */
+static double scoreToElo(double score)
+{
+	const double limit = 1e-5;
+	score = score < limit ? limit : score > 1 - limit ? 1 - limit : score;
+	return -400 * log10(1 / score - 1);
+}
+
+/**
+ * Converts an Elo difference to an expected score per game
+ * \param double elo	: [IN] Elo difference
+ * \return expected score between 0 and 1
+ */
+static double eloToScore(double elo)
+{
+	return 1 / (1 + pow(10, -elo / 400));
+}
+
+/**
+ * Computes the mean and the variance of the score per game of the game
+ * pairs. A pair is one sample, this takes into account that the two
+ * games of an opening are not independent
+ * \param const ReversiTournament::Results& results	: [IN] results
+ * \param double& mean		: [OUT] mean score per game
+ * \param double& variance	: [OUT] variance of the score of a pair
+ * \return number of pairs
+ */
+static int pairStatistics(const ReversiTournament::Results& results,
+		double& mean, double& variance)
+{
+	int count = 0;
+	double sum = 0;
+	for (int score = 0; score < 5; score++){
+		count += results.pairs[score];
+		sum += results.pairs[score] * score / 4.0;
+	}
+	mean = count > 0 ? sum / count : 0.5;
+	variance = 0;
+	for (int score = 0; score < 5; score++){
+		double deviation = score / 4.0 - mean;
+		variance += results.pairs[score] * deviation * deviation;
+	}
+	variance = count > 0 ? variance / count : 0;
+	return count;
+}
+
+/**
+ * Reads the configuration of a player. Known keys are depth, time
+ * (milliseconds), nodes, hash (megabytes), mpc (parameter file) and
+ * confidence (percent). Without any limit 100000 nodes are used
+ * \param const std::string& text	: [IN] configuration text
+ * \param Player& player			: [OUT] configuration
+ * \return false if the text has an unknown key or an invalid value
+ */
+bool ReversiTournament::parsePlayer(const string& text, Player& player)
+{
+	player.name = text;
+	player.depth = 64;
+	player.timeMs = 0;
+	player.nodes = 0;
+	player.hashMb = 16;
+	player.probCutPath.clear();
+	player.confidence = 0.95;
+
+	stringstream stream(text);
+	string item;
+	while (getline(stream, item, ',')){
+		size_t equals = item.find('=');
+		if (equals == string::npos){
+			cout << "Invalid player setting " << item << endl;
+			return false;
+		}
+		string key = item.substr(0, equals);
+		string value = item.substr(equals + 1);
+		char* end;
+		double number = strtod(value.c_str(), &end);
+		bool isNumber = !value.empty() && *end == '\0' && number >= 0;
+		if (key == "mpc"){
+			player.probCutPath = value;
+		} else if (key == "depth" && isNumber && number >= 1){
+			player.depth = (int)number;
+		} else if (key == "time" && isNumber){
+			player.timeMs = (int)number;
+		} else if (key == "nodes" && isNumber){
+			player.nodes = (uint64_t)number;
+		} else if (key == "hash" && isNumber && number >= 1){
+			player.hashMb = (int)number;
+		} else if (key == "confidence" && isNumber && number > 0 &&
+				number < 100){
+			player.confidence = number / 100;
+		} else {
+			cout << "Invalid player setting " << item << endl;
+			return false;
+		}
+	}
+	if (player.depth == 64 && player.timeMs == 0 && player.nodes == 0){
+		player.nodes = 100000;
+	}
+	return true;
+}
+
+/**
+ * Creates the openings: all move sequences of the given length from
+ * the start position that lead to different positions, also under
+ * symmetry, and that a shallow search scores as balanced. They are
+ * shuffled so that a short tournament still gets a mix
+ * \param int plies		: [IN] number of moves of an opening
+ * \param uint32_t seed	: [IN] seed of the shuffle
+ * \return moves of the openings
+ */
+vector<vector<int>> ReversiTournament::generateOpenings(int plies,
+		uint32_t seed)
+{
+	// Breadth-first over the move sequences, positions reached before
+	// by another sequence or a symmetric one are dropped on every ply
+	vector<vector<int>> sequences(1);
+	vector<ReversiPosition> positions(1, ReversiPosition::initial());
+	for (int ply = 0; ply < plies; ply++){
+		vector<vector<int>> nextSequences;
+		vector<ReversiPosition> nextPositions;
+		unordered_set<uint64_t> seen;
+		for (size_t index = 0; index < positions.size(); index++){
+			for (uint64_t moves = positions[index].validMoves(); moves;
+					moves &= moves - 1){
+				int move = __builtin_ctzll(moves);
+				ReversiPosition next = positions[index].play(move);
+				if (next.validMoves() == 0){
+					next = next.pass();
+				}
+				int symmetry;
+				if (!seen.insert(next.canonical(symmetry).hash()).second){
+					continue;
+				}
+				nextSequences.push_back(sequences[index]);
+				nextSequences.back().push_back(move);
+				nextPositions.push_back(next);
+			}
+		}
+		sequences.swap(nextSequences);
+		positions.swap(nextPositions);
+	}
+
+	vector<vector<int>> openings;
+	ReversiEngine engine(0, 0, 16);
+	for (size_t index = 0; index < positions.size(); index++){
+		if (positions[index].validMoves() != 0 &&
+				abs(engine.scorePosition(positions[index], openingDepth)) <=
+				openingMaxScore){
+			openings.push_back(sequences[index]);
+		}
+	}
+	mt19937 random(seed);
+	shuffle(openings.begin(), openings.end(), random);
+	return openings;
+}
+
+/**
+ * Reads openings from a game file, every game is one opening
+ * \param const std::string& path	: [IN] game file
+ * \param std::vector<std::vector<int>>& openings	: [OUT] moves of the
+ * 										openings
+ * \return false if the file cannot be read or has an invalid game
+ */
+bool ReversiTournament::readOpenings(const string& path,
+		vector<vector<int>>& openings)
+{
+	ifstream file(path.c_str());
+	if (!file){
+		cout << "Cannot open " << path << endl;
+		return false;
+	}
+	string line;
+	for (int lineNumber = 1; getline(file, line); lineNumber++){
+		if (!ReversiGameFile::isGame(line)){
+			continue;
+		}
+		vector<int> moves;
+		vector<ReversiPosition> positions;
+		if (!ReversiGameFile::parse(line, moves) ||
+				!ReversiGameFile::replay(moves, positions)){
+			cout << "Invalid opening in line " << lineNumber << " of " <<
+					path << endl;
+			return false;
+		}
+		openings.push_back(moves);
+	}
+	return true;
+}
+
+/**
+ * Computes the Elo difference and its 95% error bar from the results
+ * of game pairs
+ * \param const Results& results	: [IN] results of the first player
+ * \param double& elo		: [OUT] Elo difference
+ * \param double& error		: [OUT] half width of the 95% interval
+ */
+void ReversiTournament::computeElo(const Results& results, double& elo,
+		double& error)
+{
+	double mean;
+	double variance;
+	int count = pairStatistics(results, mean, variance);
+	elo = scoreToElo(mean);
+	if (count < 2){
+		error = numeric_limits<double>::infinity();
+		return;
+	}
+	double deviation = 1.96 * sqrt(variance / count);
+	error = (scoreToElo(mean + deviation) - scoreToElo(mean - deviation)) /
+			2;
+}
+
+/**
+ * Computes the log-likelihood ratio of the sequential probability
+ * ratio test of H1: Elo difference elo1 against H0: elo0, from the
+ * results of game pairs. The pair scores are approximated by a normal
+ * distribution with the measured variance (generalized SPRT)
+ * \param const Results& results	: [IN] results of the first player
+ * \param double elo0	: [IN] Elo difference of H0
+ * \param double elo1	: [IN] Elo difference of H1
+ * \return log-likelihood ratio
+ */
+double ReversiTournament::computeLlr(const Results& results, double elo0,
+		double elo1)
+{
+	double mean;
+	double variance;
+	int count = pairStatistics(results, mean, variance);
+	if (count < 2 || variance <= 0){
+		return 0;
+	}
+	double score0 = eloToScore(elo0);
+	double score1 = eloToScore(elo1);
+	return count * (score1 - score0) * (2 * mean - score0 - score1) /
+			(2 * variance);
+}
+
+/**
+ * Constructor of class ReversiTournament
+ * \param const Player& first	: [IN] first player
+ * \param const Player& second	: [IN] second player
+ * \param int threadCount		: [IN] number of threads
+ */
+ReversiTournament::ReversiTournament(const Player& first,
+		const Player& second, int threadCount):
+		threadCount(threadCount), results(), stopped(false)
+{
+	players[0] = first;
+	players[1] = second;
+}
+
+/**
+ * Plays one game. Each side gets its own engine, so nothing found by one
+ * side's search helps the other
+ * \param const std::vector<int>& opening	: [IN] moves of the opening
+ * \param bool firstIsPlayer1	: [IN] true if the first player plays
+ * 								PLAYER1
+ * \param std::vector<int>& moves	: [OUT] all moves of the game
+ * \return final disc difference from the view of the first player
+ */
+int ReversiTournament::playGame(const vector<int>& opening,
+		bool firstIsPlayer1, vector<int>& moves)
+{
+	unique_ptr<ReversiEngine> engines[2];
+	for (int side = 0; side < 2; side++){
+		engines[side].reset(new ReversiEngine(0, 0, players[side].hashMb));
+		if (!players[side].probCutPath.empty()){
+			engines[side]->setProbCut(&probCuts[side],
+					players[side].confidence);
+		}
+	}
+
+	moves = opening;
+	vector<ReversiPosition> positions;
+	ReversiGameFile::replay(opening, positions);
+	ReversiPosition position = positions.back();
+	bool passed = false;
+	while (true){
+		if (position.validMoves() == 0){
+			if (passed){
+				break;
+			}
+			position = position.pass();
+			passed = true;
+			continue;
+		}
+		passed = false;
+		int side = position.isPlayer1ToMove() == firstIsPlayer1 ? 0 : 1;
+		const Player& player = players[side];
+		ReversiEngine::SearchResult result = engines[side]->searchPosition(
+				position, player.depth, player.timeMs > 0 ? player.timeMs :
+				numeric_limits<int>::max() / 2, player.nodes);
+		moves.push_back(result.move);
+		position = position.play(result.move);
+	}
+
+	int difference = position.getDiscDifference();
+	return position.isPlayer1ToMove() == firstIsPlayer1 ? difference :
+			-difference;
+}
+
+/**
+ * Plays the tournament and prints the results after every pair. Every
+ * pair of games is one task of the pool, the results and games are
+ * recorded in the order the pairs finish
+ * \param const std::vector<std::vector<int>>& openings	: [IN] openings,
+ * 				used again from the start if there are too few
+ * \param int games		: [IN] maximum number of games, rounded up to
+ * 						pairs
+ * \param const std::string& outputPath	: [IN] file for the games
+ * \param bool sprt		: [IN] true to stop early with SPRT
+ * \param double elo0	: [IN] Elo difference of H0 of the SPRT
+ * \param double elo1	: [IN] Elo difference of H1 of the SPRT
+ * \return false if a file could not be read or written
+ */
+bool ReversiTournament::run(const vector<vector<int>>& openings,
+		int games, const string& outputPath, bool sprt, double elo0,
+		double elo1)
+{
+	if (openings.empty()){
+		cout << "No openings" << endl;
+		return false;
+	}
+	for (int side = 0; side < 2; side++){
+		if (!players[side].probCutPath.empty() &&
+				!probCuts[side].load(players[side].probCutPath)){
+			return false;
+		}
+	}
+	gameFile.open(outputPath.c_str());
+	if (!gameFile){
+		cout << "Cannot write " << outputPath << endl;
+		return false;
+	}
+
+	int pairCount = (games + 1) / 2;
+	double lowerBound = log(sprtBeta / (1 - sprtAlpha));
+	double upperBound = log((1 - sprtBeta) / sprtAlpha);
+	cout << "A: " << players[0].name << endl;
+	cout << "B: " << players[1].name << endl;
+	cout << "Up to " << 2 * pairCount << " games from " << openings.size() <<
+			" openings with " << threadCount << " threads" << endl;
+	if (sprt){
+		cout << "SPRT elo0 " << elo0 << " elo1 " << elo1 << ", bounds " <<
+				fixed << setprecision(2) << lowerBound << ' ' << upperBound <<
+				endl;
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	int gamesPlayed = 0;
+	{
+		ReversiThreadPool pool(threadCount);
+		for (int pair = 0; pair < pairCount; pair++){
+			pool.submit([&, pair]{
+				if (stopped.load()){
+					return;
+				}
+				const vector<int>& opening = openings[pair % openings.size()];
+				vector<int> moves[2];
+				int differences[2];
+				for (int game = 0; game < 2; game++){
+					differences[game] = playGame(opening, game == 0,
+							moves[game]);
+				}
+
+				lock_guard<mutex> lock(resultMutex);
+				if (stopped.load()){
+					return;
+				}
+				int pairScore = 0;
+				for (int game = 0; game < 2; game++){
+					int difference = differences[game];
+					results.wins += difference > 0;
+					results.draws += difference == 0;
+					results.losses += difference < 0;
+					pairScore += difference > 0 ? 2 : difference == 0 ? 1 : 0;
+					gameFile << "# game " << ++gamesPlayed << " opening " <<
+							pair % openings.size() + 1 << " PLAYER1 " <<
+							(game == 0 ? 'A' : 'B') << " result " <<
+							difference << '\n' <<
+							ReversiGameFile::format(moves[game]) << '\n';
+				}
+				results.pairs[pairScore]++;
+
+				double elo;
+				double error;
+				computeElo(results, elo, error);
+				double minutes = chrono::duration<double>(
+						chrono::steady_clock::now() - start).count() / 60;
+				cout << fixed << setprecision(1) << "Games " << gamesPlayed <<
+						" +" << results.wins << " =" << results.draws << " -" <<
+						results.losses << " Elo " << elo << " +- " << error;
+				if (sprt){
+					double llr = computeLlr(results, elo0, elo1);
+					cout << setprecision(2) << " LLR " << llr;
+					if (llr >= upperBound || llr <= lowerBound){
+						cout << (llr >= upperBound ? " H1" : " H0") <<
+								" accepted";
+						stopped.store(true);
+					}
+				}
+				cout << setprecision(1) << ", " << gamesPlayed / minutes <<
+						" games/min" << endl;
+			});
+		}
+	}
+	double seconds = chrono::duration<double>(
+			chrono::steady_clock::now() - start).count();
+	gameFile.close();
+	if (!gameFile){
+		cout << "Cannot write " << outputPath << endl;
+		return false;
+	}
+
+	double elo;
+	double error;
+	computeElo(results, elo, error);
+	cout << fixed << setprecision(1);
+	cout << "Played " << gamesPlayed << " games in " << seconds << " s: A +" <<
+			results.wins << " =" << results.draws << " -" << results.losses <<
+			", pairs " << results.pairs[0] << ' ' << results.pairs[1] << ' ' <<
+			results.pairs[2] << ' ' << results.pairs[3] << ' ' <<
+			results.pairs[4] << endl;
+	cout << "Elo of A: " << elo << " +- " << error << endl;
+	if (gamesPlayed > 0){
+		cout << "Games/min: " << gamesPlayed * 60 / seconds << endl;
+	}
+	return true;
+}
+
+/**
+ * Destructor of class ReversiTournament
+ */
+ReversiTournament::~ReversiTournament()
+{
+}
@@ -0,0 +1,186 @@
+/*
+ * ReversiTournament.h
+ *
+ *  Created on: 19-Oct-2026
+ *      Author: Rakshitha Kukke Prakash
+ */
+
+#ifndef REVERSITOURNAMENT_H_
+#define REVERSITOURNAMENT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ReversiProbCut.h"
+
+/**
+ * Plays games between two engine configurations on all cores. Every
+ * opening is played twice with the colors swapped, so an unbalanced
+ * opening favors neither side. After every pair the Elo difference with
+ * its 95% error bar is printed, and with SPRT the tournament stops as soon
+ * as one of the two hypotheses is accepted. All games are written to a
+ * game file that can be replayed or indexed with ReversiPositionDatabase
+ */
+class ReversiTournament
+{
+public:
+	/**
+	 * Configuration of an engine, read from a text like
+	 * nodes=100000,mpc=data/ReversiProbCut.dat,confidence=90. Searches stop
+	 * at the first limit reached
+	 */
+	struct Player{
+		std::string name;		// text the configuration was read from
+		int depth;				// depth limit, 64 for none
+		int timeMs;				// time per move, 0 for none
+		uint64_t nodes;			// nodes per move, 0 for none
+		int hashMb;				// size of the hash table
+		std::string probCutPath;// parameters of the selective search or
+								// empty for full-width search
+		double confidence;		// confidence level of the selective search
+	};
+
+	/**
+	 * Results from the view of the first player: numbers of wins, draws
+	 * and losses, and of pairs by their score from 0 to 2 in half points
+	 */
+	struct Results{
+		int wins;
+		int draws;
+		int losses;
+		int pairs[5];
+	};
+
+private:
+	/**
+	 * The two players and the parameters of their selective searches
+	 */
+	Player players[2];
+	ReversiProbCut probCuts[2];
+
+	/**
+	 * Number of threads playing games
+	 */
+	int threadCount;
+
+	/**
+	 * Results so far, guarded by resultMutex
+	 */
+	Results results;
+
+	/**
+	 * Guards results and the game file
+	 */
+	std::mutex resultMutex;
+
+	/**
+	 * File the games are written to
+	 */
+	std::ofstream gameFile;
+
+	/**
+	 * Set when SPRT has decided, games not started yet are skipped
+	 */
+	std::atomic<bool> stopped;
+
+	/**
+	 * Plays one game
+	 * \param const std::vector<int>& opening	: [IN] moves of the opening
+	 * \param bool firstIsPlayer1	: [IN] true if the first player plays
+	 * 								PLAYER1
+	 * \param std::vector<int>& moves	: [OUT] all moves of the game
+	 * \return final disc difference from the view of the first player
+	 */
+	int playGame(const std::vector<int>& opening, bool firstIsPlayer1,
+			std::vector<int>& moves);
+
+public:
+	/**
+	 * Reads the configuration of a player. Known keys are depth, time
+	 * (milliseconds), nodes, hash (megabytes), mpc (parameter file) and
+	 * confidence (percent). Without any limit 100000 nodes are used
+	 * \param const std::string& text	: [IN] configuration text
+	 * \param Player& player			: [OUT] configuration
+	 * \return false if the text has an unknown key or an invalid value
+	 */
+	static bool parsePlayer(const std::string& text, Player& player);
+
+	/**
+	 * Creates the openings: all move sequences of the given length from
+	 * the start position that lead to different positions, also under
+	 * symmetry, and that a shallow search scores as balanced. They are
+	 * shuffled so that a short tournament still gets a mix
+	 * \param int plies		: [IN] number of moves of an opening
+	 * \param uint32_t seed	: [IN] seed of the shuffle
+	 * \return moves of the openings
+	 */
+	static std::vector<std::vector<int>> generateOpenings(int plies,
+			uint32_t seed);
+
+	/**
+	 * Reads openings from a game file, every game is one opening
+	 * \param const std::string& path	: [IN] game file
+	 * \param std::vector<std::vector<int>>& openings	: [OUT] moves of the
+	 * 										openings
+	 * \return false if the file cannot be read or has an invalid game
+	 */
+	static bool readOpenings(const std::string& path,
+			std::vector<std::vector<int>>& openings);
+
+	/**
+	 * Computes the Elo difference and its 95% error bar from the results
+	 * of game pairs
+	 * \param const Results& results	: [IN] results of the first player
+	 * \param double& elo		: [OUT] Elo difference
+	 * \param double& error		: [OUT] half width of the 95% interval
+	 */
+	static void computeElo(const Results& results, double& elo,
+			double& error);
+
+	/**
+	 * Computes the log-likelihood ratio of the sequential probability
+	 * ratio test of H1: Elo difference elo1 against H0: elo0, from the
+	 * results of game pairs
+	 * \param const Results& results	: [IN] results of the first player
+	 * \param double elo0	: [IN] Elo difference of H0
+	 * \param double elo1	: [IN] Elo difference of H1
+	 * \return log-likelihood ratio
+	 */
+	static double computeLlr(const Results& results, double elo0,
+			double elo1);
+
+	/**
+	 * Constructor of class ReversiTournament
+	 * \param const Player& first	: [IN] first player
+	 * \param const Player& second	: [IN] second player
+	 * \param int threadCount		: [IN] number of threads
+	 */
+	ReversiTournament(const Player& first, const Player& second,
+			int threadCount);
+
+	/**
+	 * Plays the tournament and prints the results after every pair
+	 * \param const std::vector<std::vector<int>>& openings	: [IN] openings,
+	 * 				used again from the start if there are too few
+	 * \param int games		: [IN] maximum number of games, rounded up to
+	 * 						pairs
+	 * \param const std::string& outputPath	: [IN] file for the games
+	 * \param bool sprt		: [IN] true to stop early with SPRT
+	 * \param double elo0	: [IN] Elo difference of H0 of the SPRT
+	 * \param double elo1	: [IN] Elo difference of H1 of the SPRT
+	 * \return false if a file could not be read or written
+	 */
+	bool run(const std::vector<std::vector<int>>& openings, int games,
+			const std::string& outputPath, bool sprt, double elo0,
+			double elo1);
+
+	/**
+	 * Destructor of class ReversiTournament
+	 */
+	virtual ~ReversiTournament();
+};
+
+#endif /* REVERSITOURNAMENT_H_ */
@@ -14,29 +14,295 @@
  */
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
 /**
  * Project's header files
  */
+#include "ReversiAnalysis.h"
+#include "ReversiBatch.h"
 #include "ReversiBoard.h"
 #include "ReversiConsoleView.h"
+#include "ReversiEngine.h"
+#include "ReversiEnumerator.h"
+#include "ReversiGameAnalysis.h"
+#include "ReversiGameFile.h"
+#include "ReversiLoadGenerator.h"
+#include "ReversiPersistentCache.h"
+#include "ReversiPositionDatabase.h"
+#include "ReversiPositionFile.h"
+#include "ReversiProbCut.h"
+#include "ReversiServer.h"
+#include "ReversiSolver.h"
+#include "ReversiTournament.h"
 
 /**
  * Main program
+ * Without arguments two players enter their moves on the console.
+ * -computer lets the computer play PLAYER2, -movetime and -gametime set
+ * its thinking time per move and per game in milliseconds, -mpc switches
+ * on its selective search with the parameters of a file at the
+ * -confidence level in percent and -cache keeps its search results in a
+ * file for later games. -analysis shows the score of every valid move
+ * searched to the given depth before each move entered on the console,
+ * -record appends the moves of the game to a game file.
+ * -server runs the multi-game server on a Unix domain socket and
+ * -loadgen measures the throughput and latency of a running server,
+ * -batchbench the throughput of the batched move generation.
+ * -positions writes random positions to a file, -mpccalibrate fits the
+ * selective search parameters on such a file and -mpcbench compares the
+ * selective with the full-width search. -solve solves all positions of
+ * a file exactly on all cores, -analyze searches them with a persistent
+ * cache. -dbbuild indexes the positions of a game file and -dbquery finds
+ * the games that reached a position. -tournament plays two engine
+ * configurations against each other on all cores and -multipv prints
+ * the scores of all valid moves of a position. -enumerate writes the
+ * different positions of every ply to a directory. -grade finds the
+ * mistakes in recorded games
  */
-int main ()
+int main (int argc, char* argv[])
 {
 	int rowNum = 0;
 	int colNum = 0;
 	bool player1 = true;
+	bool computer = false;
+	int moveTimeMs = 5000;
+	int gameTimeMs = 300000;
+	const char* probCutPath = nullptr;
+	double confidence = 0.95;
+	const char* cachePath = nullptr;
+	int analysisDepth = 0;
+	const char* recordPath = nullptr;
+	if (argc >= 3 && strcmp(argv[1], "-server") == 0){
+		int workers = argc > 3 ? atoi(argv[3]) :
+				(int)thread::hardware_concurrency();
+		ReversiServer server(argv[2], workers > 0 ? workers : 1,
+				argc > 4 ? atoi(argv[4]) : 65536);
+		return server.run() ? 0 : 1;
+	}
+	if (argc >= 3 && strcmp(argv[1], "-loadgen") == 0){
+		ReversiLoadGenerator generator(argv[2],
+				argc > 3 ? atoi(argv[3]) : 64, argc > 4 ? atoi(argv[4]) : 32,
+				argc > 5 ? atoi(argv[5]) : 10000,
+				argc > 6 ? atoi(argv[6]) : 4);
+		return generator.run() ? 0 : 1;
+	}
+	if (argc >= 2 && strcmp(argv[1], "-batchbench") == 0){
+		int count = argc > 2 ? atoi(argv[2]) : 4096;
+		ReversiBatch::benchmark(count > 0 ? count : 4096);
+		return 0;
+	}
+	if (argc >= 4 && strcmp(argv[1], "-positions") == 0){
+		return ReversiPositionFile::write(argv[2],
+				ReversiPositionFile::generate(atoi(argv[3]),
+						argc > 4 ? atoi(argv[4]) : 14,
+						argc > 5 ? atoi(argv[5]) : 50,
+						argc > 6 ? atoi(argv[6]) : 1)) ? 0 : 1;
+	}
+	if (argc >= 4 && strcmp(argv[1], "-solve") == 0){
+		int threads = argc > 4 ? atoi(argv[4]) :
+				(int)thread::hardware_concurrency();
+		return ReversiSolver::solveFile(argv[2], argv[3],
+				threads > 0 ? threads : 1,
+				argc > 5 ? atoi(argv[5]) : 256) ? 0 : 1;
+	}
+	if (argc >= 4 && strcmp(argv[1], "-analyze") == 0){
+		return ReversiPersistentCache::analyze(argv[2], argv[3],
+				argc > 4 ? atoi(argv[4]) : 10,
+				argc > 5 ? atoi(argv[5]) : 256) ? 0 : 1;
+	}
+	if (argc >= 4 && strcmp(argv[1], "-dbbuild") == 0){
+		return ReversiPositionDatabase::build(argv[2], argv[3],
+				argc > 4 ? atoi(argv[4]) : 1024) ? 0 : 1;
+	}
+	if (argc >= 4 && strcmp(argv[1], "-dbquery") == 0){
+		return ReversiPositionDatabase::query(argv[2],
+				argc > 4 ? argv[4] : "", argv[3],
+				argc > 5 ? atoi(argv[5]) : 20) ? 0 : 1;
+	}
+	if (argc >= 4 && strcmp(argv[1], "-mpccalibrate") == 0){
+		return ReversiProbCut::calibrate(argv[2], argv[3],
+				argc > 4 ? atoi(argv[4]) : 10) ? 0 : 1;
+	}
+	if (argc >= 4 && strcmp(argv[1], "-mpcbench") == 0){
+		return ReversiProbCut::benchmark(argv[2], argv[3],
+				argc > 4 ? atoi(argv[4]) : 8,
+				argc > 5 ? atof(argv[5]) / 100 : confidence,
+				argc > 6 ? atoi(argv[6]) : 500) ? 0 : 1;
+	}
+	if (argc >= 6 && strcmp(argv[1], "-tournament") == 0){
+		ReversiTournament::Player players[2];
+		if (!ReversiTournament::parsePlayer(argv[2], players[0]) ||
+				!ReversiTournament::parsePlayer(argv[3], players[1])){
+			return 1;
+		}
+		int threads = argc > 6 ? atoi(argv[6]) :
+				(int)thread::hardware_concurrency();
+		const char* openingText = argc > 7 ? argv[7] : "6";
+		vector<vector<int>> openings;
+		if (strspn(openingText, "0123456789") == strlen(openingText)){
+			openings = ReversiTournament::generateOpenings(atoi(openingText),
+					1);
+		}
+		else if (!ReversiTournament::readOpenings(openingText, openings)){
+			return 1;
+		}
+		ReversiTournament tournament(players[0], players[1],
+				threads > 0 ? threads : 1);
+		return tournament.run(openings, atoi(argv[4]), argv[5], argc > 9,
+				argc > 9 ? atof(argv[8]) : 0,
+				argc > 9 ? atof(argv[9]) : 0) ? 0 : 1;
+	}
+	if (argc >= 4 && strcmp(argv[1], "-enumerate") == 0){
+		int threads = argc > 4 ? atoi(argv[4]) :
+				(int)thread::hardware_concurrency();
+		return ReversiEnumerator::enumerate(argv[3], atoi(argv[2]),
+				threads > 0 ? threads : 1,
+				argc > 5 ? atoi(argv[5]) : 1024) ? 0 : 1;
+	}
+	if (argc >= 3 && strcmp(argv[1], "-grade") == 0){
+		int threads = argc > 5 ? atoi(argv[5]) :
+				(int)thread::hardware_concurrency();
+		return ReversiGameAnalysis::run(argv[2],
+				argc > 3 ? atoi(argv[3]) : 10,
+				argc > 4 ? atoi(argv[4]) : 18,
+				threads > 0 ? threads : 1) ? 0 : 1;
+	}
+	if (argc >= 4 && strcmp(argv[1], "-multipv") == 0){
+		int threads = argc > 4 ? atoi(argv[4]) :
+				(int)thread::hardware_concurrency();
+		return ReversiAnalysis::run(argv[2], atoi(argv[3]),
+				threads > 0 ? threads : 1) ? 0 : 1;
+	}
+	for (int arg = 1; arg < argc; arg++){
+		if (strcmp(argv[arg], "-computer") == 0){
+			computer = true;
+		}
+		else if (strcmp(argv[arg], "-movetime") == 0 && arg + 1 < argc){
+			moveTimeMs = atoi(argv[++arg]);
+		}
+		else if (strcmp(argv[arg], "-gametime") == 0 && arg + 1 < argc){
+			gameTimeMs = atoi(argv[++arg]);
+		}
+		else if (strcmp(argv[arg], "-mpc") == 0 && arg + 1 < argc){
+			probCutPath = argv[++arg];
+		}
+		else if (strcmp(argv[arg], "-confidence") == 0 && arg + 1 < argc){
+			confidence = atof(argv[++arg]) / 100;
+		}
+		else if (strcmp(argv[arg], "-cache") == 0 && arg + 1 < argc){
+			cachePath = argv[++arg];
+		}
+		else if (strcmp(argv[arg], "-analysis") == 0 && arg + 1 < argc){
+			analysisDepth = atoi(argv[++arg]);
+		}
+		else if (strcmp(argv[arg], "-record") == 0 && arg + 1 < argc){
+			recordPath = argv[++arg];
+		}
+		else{
+			cout << "Usage: " << argv[0] << " [-computer] [-movetime ms]"
+					" [-gametime ms] [-mpc file] [-confidence percent]"
+					" [-cache file] [-analysis depth] [-record file]" << endl;
+			cout << "       " << argv[0] << " -server socket [workers]"
+					" [games]" << endl;
+			cout << "       " << argv[0] << " -loadgen socket [connections]"
+					" [games] [requests] [depth]" << endl;
+			cout << "       " << argv[0] << " -batchbench [positions]" << endl;
+			cout << "       " << argv[0] << " -positions file count"
+					" [minempties] [maxempties] [seed]" << endl;
+			cout << "       " << argv[0] << " -solve positions results"
+					" [threads] [hashmb]" << endl;
+			cout << "       " << argv[0] << " -analyze positions cache"
+					" [depth] [cachemb]" << endl;
+			cout << "       " << argv[0] << " -dbbuild games database"
+					" [memorymb]" << endl;
+			cout << "       " << argv[0] << " -dbquery database moves|position"
+					" [games] [limit]" << endl;
+			cout << "       " << argv[0] << " -mpccalibrate positions file"
+					" [depth]" << endl;
+			cout << "       " << argv[0] << " -mpcbench positions file"
+					" [depth] [confidence] [ms]" << endl;
+			cout << "       " << argv[0] << " -tournament playerA playerB"
+					" games output [threads] [openings|plies] [elo0 elo1]" <<
+					endl;
+			cout << "       player: depth=n,time=ms,nodes=n,hash=mb,"
+					"mpc=file,confidence=percent" << endl;
+			cout << "       " << argv[0] << " -multipv moves|position depth"
+					" [threads]" << endl;
+			cout << "       " << argv[0] << " -enumerate plies directory"
+					" [threads] [memorymb]" << endl;
+			cout << "       " << argv[0] << " -grade games|moves [depth]"
+					" [exactempties] [threads]" << endl;
+			return 1;
+		}
+	}
 	cout << "ReversiBoard game started." << endl;
 	ReversiBoard b1;
 	ReversiConsoleView b2(&b1);
+	ReversiEngine engine(moveTimeMs, gameTimeMs);
+	ReversiProbCut probCut;
+	if (probCutPath){
+		if (!probCut.load(probCutPath)){
+			return 1;
+		}
+		engine.setProbCut(&probCut, confidence);
+	}
+	ReversiPersistentCache cache;
+	if (cachePath){
+		if (!cache.open(cachePath, 256)){
+			return 1;
+		}
+		engine.setPersistentCache(&cache);
+	}
 
+	unique_ptr<ReversiAnalysis> analysis;
+	if (analysisDepth > 0){
+		int threads = (int)thread::hardware_concurrency();
+		analysis.reset(new ReversiAnalysis(threads > 0 ? threads : 1));
+	}
+
+	vector<int> moves;
 	while(b1.boardNotFull()){
+		vector<ReversiAnalysis::MoveScore> scores;
+		if (analysis && !(computer && !player1)){
+			scores = analysis->analyze(b1.getPosition(player1),
+					analysisDepth);
+		}
+		b2.setAnalysis(analysis ? &scores : nullptr);
 		b2.print();
+		if (!b1.hasValidMove(player1)){
+			if (!b1.hasValidMove(!player1)){
+				cout << "No player can move. Game over" << endl;
+				break;
+			}
+			cout << (player1 ? "PLAYER1" : "PLAYER2") <<
+					" has no valid move and passes." << endl;
+			player1 = !player1;
+			continue;
+		}
+		if (computer && !player1){
+			// While the human thinks the engine ponders on the opponent's
+			// expected reply, so the search usually is done when the human
+			// has moved
+			ReversiEngine::SearchResult result = engine.findMove(b1, false);
+			rowNum = result.move / 8 + 1;
+			colNum = result.move % 8 + 1;
+			cout << "PLAYER2 (computer) plays " << rowNum << " " << colNum
+					<< " (depth " << result.depth << ", score "
+					<< result.score << ", clock " << engine.getClockMs()
+					<< " ms)" << endl;
+			b1.setField(rowNum, colNum, false);
+			moves.push_back(result.move);
+			engine.startPondering(b1, false, result.reply);
+			player1 = !player1;
+			continue;
+		}
 		if (player1){
 			cout << "PLAYER1, enter the position of your piece (row column): "
 					<<endl;
@@ -47,11 +313,23 @@ int main ()
 		}
 		cin >> rowNum >> colNum;
 
-		while (!b1.setField(rowNum, colNum, player1)) {
+		while (cin && !b1.setField(rowNum, colNum, player1)) {
 		        cin >> rowNum >> colNum;
 		    }
+		if (!cin){
+			break;
+		}
+		moves.push_back((rowNum - 1) * 8 + colNum - 1);
 
 		    player1 = !player1;
 	}
+	if (recordPath && !moves.empty()){
+		ofstream record(recordPath, ios::app);
+		record << ReversiGameFile::format(moves) << endl;
+		if (!record){
+			cout << "Cannot write " << recordPath << endl;
+			return 1;
+		}
+	}
 	return 0;
 }